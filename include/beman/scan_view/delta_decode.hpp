@@ -0,0 +1,438 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_DELTA_DECODE_HPP
+#define BEMAN_SCAN_VIEW_DELTA_DECODE_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <concepts>
+        #include <cstddef>
+        #include <cstdint>
+        #include <functional>
+        #include <limits>
+        #include <ranges>
+        #include <type_traits>
+        #include <utility>
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+    #include "scan.hpp"
+
+namespace beman::scan_view {
+
+namespace detail {
+
+template <class B>
+concept byte_like = // exposition only
+    sizeof(B) == 1 && (std::integral<B> || std::same_as<B, std::byte>);
+
+// Shifts and masks that are defined for a count equal to the width of `W`, which fixed-width fields may use.
+template <std::unsigned_integral W>
+constexpr W shr(W v, unsigned n) noexcept { // exposition only
+    return n >= std::numeric_limits<W>::digits ? W(0) : static_cast<W>(v >> n);
+}
+template <std::unsigned_integral W>
+constexpr W shl(W v, unsigned n) noexcept { // exposition only
+    return n >= std::numeric_limits<W>::digits ? W(0) : static_cast<W>(v << n);
+}
+template <std::unsigned_integral W>
+constexpr W low_bits(W v, unsigned n) noexcept { // exposition only
+    return n >= std::numeric_limits<W>::digits ? v : static_cast<W>(v & static_cast<W>(shl(W(1), n) - 1u));
+}
+
+template <std::integral T>
+constexpr T zigzag_decode(std::make_unsigned_t<T> u) noexcept { // exposition only
+    if constexpr (std::is_signed_v<T>)
+        return static_cast<T>(static_cast<std::make_unsigned_t<T> >(u >> 1) ^
+                              static_cast<std::make_unsigned_t<T> >(-static_cast<std::make_unsigned_t<T> >(u & 1u)));
+    else
+        return u;
+}
+
+} // namespace detail
+
+// A view of the integers stored as LEB128 varints in a range of bytes. For a signed `T` the varints hold
+// zigzag-encoded values, so small negative deltas stay short. A truncated last varint ends the view. Bits of a varint
+// beyond the width of `T` are discarded, so an over-long varint decodes to its low bits.
+template <std::ranges::input_range V, std::integral T>
+    requires std::ranges::view<V> && detail::byte_like<std::ranges::range_value_t<V> >
+class varint_view : public std::ranges::view_interface<varint_view<V, T> > {
+  private:
+    template <bool>
+    class iterator; // exposition only
+
+    V base_ = V(); // exposition only
+
+  public:
+    varint_view()
+        requires std::default_initializable<V>
+    = default;
+    constexpr explicit varint_view(V base) : base_{std::move(base)} {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr iterator<false> begin() { return iterator<false>{std::ranges::begin(base_), std::ranges::end(base_)}; }
+    constexpr iterator<true>  begin() const
+        requires std::ranges::input_range<const V>
+    {
+        return iterator<true>{std::ranges::begin(base_), std::ranges::end(base_)};
+    }
+
+    [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+};
+
+template <std::ranges::input_range V, std::integral T>
+    requires std::ranges::view<V> && detail::byte_like<std::ranges::range_value_t<V> >
+template <bool Const>
+class varint_view<V, T>::iterator {
+  private:
+    using Base = detail::maybe_const<Const, V>; // exposition only
+    using U    = std::make_unsigned_t<T>;       // exposition only
+
+    std::ranges::iterator_t<Base> current_ = std::ranges::iterator_t<Base>(); // exposition only
+    std::ranges::sentinel_t<Base> end_     = std::ranges::sentinel_t<Base>(); // exposition only
+    T                             value_   = T();                             // exposition only
+    bool                          done_    = true;                            // exposition only
+
+    constexpr void read() { // exposition only
+        if (current_ == end_) {
+            done_ = true;
+            return;
+        }
+        U        u     = 0;
+        unsigned shift = 0;
+        for (;;) {
+            const auto byte = static_cast<unsigned char>(*current_);
+            ++current_;
+            u = static_cast<U>(u | detail::shl(static_cast<U>(byte & 0x7fu), shift));
+            shift += 7;
+            if (!(byte & 0x80u))
+                break;
+            if (current_ == end_) {
+                done_ = true;
+                return;
+            }
+        }
+        value_ = detail::zigzag_decode<T>(u);
+    }
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = T;
+    using difference_type  = std::ranges::range_difference_t<Base>;
+
+    iterator()
+        requires std::default_initializable<std::ranges::iterator_t<Base> >
+    = default;
+    constexpr iterator(std::ranges::iterator_t<Base> current, std::ranges::sentinel_t<Base> end)
+        : current_{std::move(current)}, end_{std::move(end)}, done_{false} {
+        read();
+    }
+
+    constexpr const value_type& operator*() const noexcept { return value_; }
+
+    constexpr iterator& operator++() {
+        read();
+        return *this;
+    }
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) noexcept { return x.done_; }
+};
+
+// A view of `count` unsigned fields of `bit_width` bits, packed LSB-first and contiguously (fields may straddle word
+// boundaries) into a range of unsigned words, each added to the frame of reference `reference`. `bit_width` must not
+// exceed the width of the word type or of `T`. Words missing at the end of a short range read as zero.
+template <std::ranges::input_range V, std::integral T>
+    requires std::ranges::view<V> && std::unsigned_integral<std::ranges::range_value_t<V> >
+class bit_unpack_view : public std::ranges::view_interface<bit_unpack_view<V, T> > {
+  private:
+    template <bool>
+    class iterator; // exposition only
+
+    template <bool>
+    friend class iterator; // exposition only
+
+    V           base_      = V(); // exposition only
+    unsigned    bit_width_ = 0;   // exposition only
+    std::size_t count_     = 0;   // exposition only
+    T           reference_ = T(); // exposition only
+
+  public:
+    bit_unpack_view()
+        requires std::default_initializable<V>
+    = default;
+    constexpr bit_unpack_view(V base, unsigned bit_width, std::size_t count, T reference = T())
+        : base_{std::move(base)}, bit_width_{bit_width}, count_{count}, reference_{reference} {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr iterator<false> begin() { return iterator<false>{*this}; }
+    constexpr iterator<true>  begin() const
+        requires std::ranges::input_range<const V>
+    {
+        return iterator<true>{*this};
+    }
+
+    [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    constexpr std::size_t size() const noexcept { return count_; }
+};
+
+template <class R, class T>
+bit_unpack_view(R&&, unsigned, std::size_t, T) -> bit_unpack_view<std::views::all_t<R>, T>;
+
+template <std::ranges::input_range V, std::integral T>
+    requires std::ranges::view<V> && std::unsigned_integral<std::ranges::range_value_t<V> >
+template <bool Const>
+class bit_unpack_view<V, T>::iterator {
+  private:
+    using Parent = detail::maybe_const<Const, bit_unpack_view>; // exposition only
+    using Base   = detail::maybe_const<Const, V>;               // exposition only
+    using W      = std::ranges::range_value_t<V>;               // exposition only
+
+    static constexpr unsigned digits = std::numeric_limits<W>::digits; // exposition only
+
+    std::ranges::iterator_t<Base> current_   = std::ranges::iterator_t<Base>(); // exposition only
+    std::ranges::sentinel_t<Base> end_       = std::ranges::sentinel_t<Base>(); // exposition only
+    W                             buf_       = 0;                               // exposition only
+    unsigned                      avail_     = 0;                               // exposition only
+    unsigned                      bit_width_ = 0;                               // exposition only
+    std::size_t                   remaining_ = 0;                               // exposition only
+    T                             reference_ = T();                             // exposition only
+    T                             value_     = T();                             // exposition only
+
+    constexpr void read() { // exposition only
+        W v;
+        if (avail_ >= bit_width_) {
+            v    = detail::low_bits(buf_, bit_width_);
+            buf_ = detail::shr(buf_, bit_width_);
+            avail_ -= bit_width_;
+        } else {
+            W next = 0;
+            if (current_ != end_) {
+                next = static_cast<W>(*current_);
+                ++current_;
+            }
+            v      = detail::low_bits(static_cast<W>(buf_ | detail::shl(next, avail_)), bit_width_);
+            buf_   = detail::shr(next, bit_width_ - avail_);
+            avail_ = digits - (bit_width_ - avail_);
+        }
+        value_ = static_cast<T>(reference_ + static_cast<T>(v));
+    }
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = T;
+    using difference_type  = std::ranges::range_difference_t<Base>;
+
+    iterator()
+        requires std::default_initializable<std::ranges::iterator_t<Base> >
+    = default;
+    constexpr explicit iterator(Parent& parent)
+        : current_{std::ranges::begin(parent.base_)},
+          end_{std::ranges::end(parent.base_)},
+          bit_width_{parent.bit_width_},
+          remaining_{parent.count_},
+          reference_{parent.reference_} {
+        if (remaining_ != 0)
+            read();
+    }
+
+    constexpr const value_type& operator*() const noexcept { return value_; }
+
+    constexpr iterator& operator++() {
+        if (--remaining_ != 0)
+            read();
+        return *this;
+    }
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) noexcept {
+        return x.remaining_ == 0;
+    }
+};
+
+namespace detail {
+
+struct delta_decode_varint_t {
+    constexpr delta_decode_varint_t() = default;
+    template <std::ranges::viewable_range R, std::integral T>
+    constexpr auto operator()(R&& bytes, T base) const {
+        return scan_view{varint_view<std::views::all_t<R>, T>{std::views::all(std::forward<R>(bytes))},
+                         std::plus<T>{},
+                         std::move(base)};
+    }
+
+    template <std::integral T>
+    constexpr auto operator()(T base) const {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this, std::move(base)));
+    }
+};
+
+struct delta_decode_bitpacked_t {
+    constexpr delta_decode_bitpacked_t() = default;
+    template <std::ranges::viewable_range R, std::integral T>
+    constexpr auto operator()(
+        R&& words, unsigned bit_width, std::size_t count, T base, std::type_identity_t<T> min_delta = T()) const {
+        return scan_view{
+            bit_unpack_view<std::views::all_t<R>, T>{
+                std::views::all(std::forward<R>(words)), bit_width, count, min_delta},
+            std::plus<T>{},
+            std::move(base)};
+    }
+
+    template <std::integral T>
+    constexpr auto
+    operator()(unsigned bit_width, std::size_t count, T base, std::type_identity_t<T> min_delta = T()) const {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this, bit_width, count, base, min_delta));
+    }
+};
+
+} // namespace detail
+
+// Decodes a delta-encoded column: `bytes | delta_decode_varint(base)` is the running sum, starting from `base`, of
+// the varints in `bytes` (zigzag-encoded for a signed `base`), without materializing the deltas.
+inline constexpr detail::delta_decode_varint_t delta_decode_varint{};
+
+// Decodes a bit-packed, delta-encoded column: each of the `count` packed fields of `bit_width` bits is the delta
+// minus `min_delta` (frame of reference), and the view is the running sum of the deltas starting from `base`.
+inline constexpr detail::delta_decode_bitpacked_t delta_decode_bitpacked{};
+
+namespace detail {
+
+// The field at `bit` bits from `w` of a packed block, where the word `bit / digits` is not the last one. Loading the
+// following word unconditionally makes the extraction branch-free: its bits are masked off when the field does not
+// straddle. The offset is 32-bit so that the loads vectorize as gathers with 32-bit indices.
+template <class W, class It>
+constexpr W extract_field(It w, std::uint32_t bit, W mask) noexcept { // exposition only
+    constexpr unsigned  digits = std::numeric_limits<W>::digits;
+    const std::uint32_t index  = bit / digits;
+    const unsigned      offset = bit % digits;
+    if constexpr (digits <= 32) {
+        // Both words fit in one 64-bit window, so no shift count can reach the width of the operand.
+        const std::uint64_t window =
+            static_cast<std::uint64_t>(w[index]) | (static_cast<std::uint64_t>(w[index + 1]) << digits);
+        return static_cast<W>(static_cast<W>(window >> offset) & mask);
+    } else {
+        return static_cast<W>(
+            (shr(static_cast<W>(w[index]), offset) | shl(static_cast<W>(w[index + 1]), digits - offset)) & mask);
+    }
+}
+
+} // namespace detail
+
+// Eager counterpart of `delta_decode_bitpacked` for one block, writing `std::ranges::size(out)` absolute values to
+// `out` and returning the last one (the base of the next block), or `base` for an empty block. The block is decoded
+// in chunks: the fields of a chunk are unpacked into a local buffer, prefix-summed within groups of `group` lanes in
+// log2(group) element-wise steps, and offset by the carry of the preceding groups, which is the only sequential part.
+// Every other loop has independent iterations that the compiler can vectorize. The sums wrap around in the unsigned
+// counterpart of the value type. As in `bit_unpack_view`, words missing at the end of a short `words` read as zero.
+template <std::ranges::random_access_range Words, std::ranges::random_access_range Out>
+    requires std::unsigned_integral<std::ranges::range_value_t<Words> > && std::ranges::sized_range<Words> &&
+             std::integral<std::ranges::range_value_t<Out> > && std::ranges::sized_range<Out> &&
+             std::ranges::output_range<Out, std::ranges::range_value_t<Out> >
+constexpr std::ranges::range_value_t<Out>
+delta_decode_bitpacked_block(Words&&                         words,
+                             unsigned                        bit_width,
+                             std::ranges::range_value_t<Out> base,
+                             Out&&                           out,
+                             std::ranges::range_value_t<Out> min_delta = {}) {
+    using W = std::ranges::range_value_t<Words>;
+    using T = std::ranges::range_value_t<Out>;
+    using U = std::make_unsigned_t<T>;
+    using D = std::ranges::range_difference_t<Out>;
+
+    constexpr unsigned    digits = std::numeric_limits<W>::digits;
+    constexpr std::size_t group  = 8;
+    constexpr std::size_t chunk  = 32 * group;
+
+    const auto w      = std::ranges::begin(words);
+    const auto o      = std::ranges::begin(out);
+    const auto n      = static_cast<std::size_t>(std::ranges::distance(out));
+    const auto nwords = static_cast<std::size_t>(std::ranges::distance(words));
+    const W    mask   = detail::low_bits(static_cast<W>(~W(0)), bit_width);
+    const U    delta  = static_cast<U>(min_delta);
+
+    // The fields before `safe` do not lie in the last word, so `detail::extract_field` may read the following one.
+    std::size_t safe = 0;
+    if (bit_width != 0 && nwords > 1)
+        safe = std::ranges::min(n, ((nwords - 1) * digits + bit_width - 1) / bit_width);
+
+    U           sum = static_cast<U>(base);
+    std::size_t i   = 0;
+    for (; i + chunk <= safe; i += chunk) {
+        // Offsets within a chunk are relative to its first word and fit in 32 bits.
+        const std::size_t   first = i * bit_width;
+        const auto          wc    = w + static_cast<std::ranges::range_difference_t<Words> >(first / digits);
+        const std::uint32_t bit0  = static_cast<std::uint32_t>(first % digits);
+        U                   lane[chunk];
+        U                   shifted[chunk];
+        for (std::uint32_t k = 0; k < chunk; ++k)
+            lane[k] = static_cast<U>(delta + static_cast<U>(detail::extract_field(wc, bit0 + k * bit_width, mask)));
+        for (std::size_t step = 1; step < group; step *= 2) {
+            for (std::size_t k = 0; k < chunk; ++k)
+                shifted[k] = k % group >= step ? lane[k - step] : U(0);
+            for (std::size_t k = 0; k < chunk; ++k)
+                lane[k] = static_cast<U>(lane[k] + shifted[k]);
+        }
+        for (std::size_t g = 0; g < chunk; g += group) {
+            const U carry = sum;
+            sum           = static_cast<U>(sum + lane[g + group - 1]);
+            for (std::size_t k = g; k < g + group; ++k)
+                lane[k] = static_cast<U>(carry + lane[k]);
+        }
+        for (std::size_t k = 0; k < chunk; ++k)
+            o[static_cast<D>(i + k)] = static_cast<T>(lane[k]);
+    }
+    // The remaining fields may lie in the last word, or past the end of a short `words`, whose missing words read as
+    // zero as in `bit_unpack_view`.
+    for (; i < n; ++i) {
+        const std::size_t bit    = i * bit_width;
+        const std::size_t index  = bit / digits;
+        const unsigned    offset = static_cast<unsigned>(bit % digits);
+        const auto        word   = [&](std::size_t k) {
+            return k < nwords ? static_cast<W>(w[static_cast<std::ranges::range_difference_t<Words> >(k)]) : W(0);
+        };
+        W v = bit_width == 0 ? W(0) : detail::shr(word(index), offset);
+        if (offset + bit_width > digits)
+            v = static_cast<W>(v | detail::shl(word(index + 1), digits - offset));
+        sum                  = static_cast<U>(sum + delta + static_cast<U>(v & mask));
+        o[static_cast<D>(i)] = static_cast<T>(sum);
+    }
+    return static_cast<T>(sum);
+}
+
+} // namespace beman::scan_view
+
+template <std::ranges::input_range V, std::integral T>
+constexpr bool std::ranges::enable_borrowed_range<beman::scan_view::varint_view<V, T> > =
+    std::ranges::enable_borrowed_range<V>;
+
+template <std::ranges::input_range V, std::integral T>
+constexpr bool std::ranges::enable_borrowed_range<beman::scan_view::bit_unpack_view<V, T> > =
+    std::ranges::enable_borrowed_range<V>;
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_DELTA_DECODE_HPP
@@ -9,6 +9,7 @@
 
     #include <concepts>
     #include <functional>
+    #include <memory>
     #include <optional>
     #include <ranges>
     #include <type_traits>
@@ -85,6 +86,76 @@ class movable_box {
     [[nodiscard]] constexpr bool has_value() const noexcept { return val_.has_value(); }
 };
 
+// This partial specialization implements an optimization for when we know we don't need to store
+// an empty state to represent failure to perform an assignment. For copy-assignment, this happens if:
+//
+// 1. The type is copyable (which includes copy-assignment), or
+// 2. The type has a nothrow copy constructor, in which case we can destroy and re-construct.
+//
+// Similarly for move-assignment with movable and nothrow move construction. Storing the object
+// directly removes the engaged flag and the branch on it, so trivially copyable accumulators stay
+// in registers.
+template <class Tp>
+concept doesnt_need_empty_state_for_copy = std::copyable<Tp> || std::is_nothrow_copy_constructible_v<Tp>;
+
+template <class Tp>
+concept doesnt_need_empty_state_for_move = std::movable<Tp> || std::is_nothrow_move_constructible_v<Tp>;
+
+template <movable_box_object Tp>
+    requires doesnt_need_empty_state_for_copy<Tp> && doesnt_need_empty_state_for_move<Tp>
+class movable_box<Tp> {
+    [[no_unique_address]] Tp val_;
+
+  public:
+    template <class... Args>
+        requires std::is_constructible_v<Tp, Args...>
+    constexpr explicit movable_box(std::in_place_t,
+                                   Args&&... args) noexcept(std::is_nothrow_constructible_v<Tp, Args...>)
+        : val_(std::forward<Args>(args)...) {}
+
+    constexpr movable_box() noexcept(std::is_nothrow_default_constructible_v<Tp>)
+        requires std::default_initializable<Tp>
+        : val_() {}
+
+    movable_box(const movable_box&) = default;
+    movable_box(movable_box&&)      = default;
+
+    // Implementation of assignment operators in case we perform optimization (1)
+    movable_box& operator=(const movable_box&)
+        requires std::copyable<Tp>
+    = default;
+    movable_box& operator=(movable_box&&)
+        requires std::movable<Tp>
+    = default;
+
+    // Implementation of assignment operators in case we perform optimization (2)
+    constexpr movable_box& operator=(const movable_box& other) noexcept {
+        static_assert(std::is_nothrow_copy_constructible_v<Tp>);
+        if (this != std::addressof(other)) {
+            std::destroy_at(std::addressof(val_));
+            std::construct_at(std::addressof(val_), other.val_);
+        }
+        return *this;
+    }
+
+    constexpr movable_box& operator=(movable_box&& other) noexcept {
+        static_assert(std::is_nothrow_move_constructible_v<Tp>);
+        if (this != std::addressof(other)) {
+            std::destroy_at(std::addressof(val_));
+            std::construct_at(std::addressof(val_), std::move(other.val_));
+        }
+        return *this;
+    }
+
+    constexpr const Tp& operator*() const noexcept { return val_; }
+    constexpr Tp&       operator*() noexcept { return val_; }
+
+    constexpr const Tp* operator->() const noexcept { return std::addressof(val_); }
+    constexpr Tp*       operator->() noexcept { return std::addressof(val_); }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return true; }
+};
+
 template <bool Const, class Tp>
 using maybe_const = std::conditional_t<Const, const Tp, Tp>;
 
@@ -248,6 +319,22 @@ bind_back(Fn&& f, Args&&... args) noexcept(noexcept(bind_back_t<std::decay_t<Fn>
         std::forward<Fn>(f), std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
+// Copies of an allocator-aware initial value keep its allocator, rather than the one chosen by
+// `select_on_container_copy_construction`, so that the accumulator stays in the memory resource chosen by the caller.
+// Other initial values are passed through unchanged.
+template <class T>
+concept allocator_aware = // exposition only
+    requires(const T& t) { t.get_allocator(); } &&
+    std::uses_allocator_v<T, std::remove_cvref_t<decltype(std::declval<const T&>().get_allocator())> >;
+
+template <class T>
+constexpr decltype(auto) seed_copy(const T& init) {
+    if constexpr (allocator_aware<T>)
+        return std::make_obj_using_allocator<T>(init.get_allocator(), init);
+    else
+        return (init);
+}
+
 template <class F>
 constexpr bool tidy_func =
     std::is_empty_v<F> && std::is_trivially_default_constructible_v<F> && std::is_trivially_destructible_v<F>;
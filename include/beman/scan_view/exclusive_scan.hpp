@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_EXCLUSIVE_SCAN_HPP
+#define BEMAN_SCAN_VIEW_EXCLUSIVE_SCAN_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <algorithm>
+        #include <concepts>
+        #include <cstddef>
+        #include <functional>
+        #include <ranges>
+        #include <type_traits>
+        #include <utility>
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+    #include "scan.hpp"
+
+namespace beman::scan_view {
+
+// Whether the running value after the last element (the "total") is produced as an additional element.
+enum class exclusive_scan_kind : bool { without_total, with_total };
+
+// A lazy view version of `std::exclusive_scan`. The i-th element is the left fold of `init` with the first i elements
+// of the underlying range, so the first element is always `init`. With `exclusive_scan_kind::with_total` the view has
+// n + 1 elements and the last one is the fold of the whole range, which is the layout of bucket offsets and CSR row
+// pointers.
+template <std::ranges::input_range V,
+          std::move_constructible  F,
+          std::move_constructible  T,
+          exclusive_scan_kind      K = exclusive_scan_kind::without_total>
+    requires std::ranges::view<V> && std::is_object_v<F> && std::is_object_v<T> &&
+             scannable<V, F, T, scan_view_kind::seeded>
+class exclusive_scan_view : public std::ranges::view_interface<exclusive_scan_view<V, F, T, K> > {
+  private:
+    template <bool>
+    class iterator; // exposition only
+
+    template <bool>
+    friend class iterator; // exposition only
+
+    V                      base_ = V(); // exposition only
+    detail::movable_box<F> fun_;        // exposition only
+    detail::movable_box<T> init_;       // exposition only
+
+  public:
+    exclusive_scan_view()
+        requires std::default_initializable<V> && std::default_initializable<F> && std::default_initializable<T>
+    = default;
+    constexpr explicit exclusive_scan_view(V base, F fun, T init)
+        : base_{std::move(base)}, fun_{std::in_place, std::move(fun)}, init_{std::in_place, std::move(init)} {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr iterator<false> begin() { return iterator<false>{*this, std::ranges::begin(base_)}; }
+    constexpr iterator<true>  begin() const
+        requires std::ranges::range<const V> && scannable<const V, const F, T, scan_view_kind::seeded>
+    {
+        return iterator<true>{*this, std::ranges::begin(base_)};
+    }
+
+    [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    constexpr auto size()
+        requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(base_) + (K == exclusive_scan_kind::with_total);
+    }
+    constexpr auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        return std::ranges::size(base_) + (K == exclusive_scan_kind::with_total);
+    }
+
+    #if __cpp_lib_ranges_reserve_hint >= 202502L
+    constexpr auto reserve_hint()
+        requires std::ranges::approximately_sized_range<V>
+    {
+        return std::ranges::reserve_hint(base_) + (K == exclusive_scan_kind::with_total);
+    }
+
+    constexpr auto reserve_hint() const
+        requires std::ranges::approximately_sized_range<const V>
+    {
+        return std::ranges::reserve_hint(base_) + (K == exclusive_scan_kind::with_total);
+    }
+    #endif
+};
+
+template <class R, class F, class T>
+exclusive_scan_view(R&&, F, T) -> exclusive_scan_view<std::views::all_t<R>, F, T>;
+
+template <std::ranges::input_range V, std::move_constructible F, std::move_constructible T, exclusive_scan_kind K>
+    requires std::ranges::view<V> && std::is_object_v<F> && std::is_object_v<T> &&
+             scannable<V, F, T, scan_view_kind::seeded>
+template <bool Const>
+class exclusive_scan_view<V, F, T, K>::iterator {
+  private:
+    using Parent     = detail::maybe_const<Const, exclusive_scan_view>; // exposition only
+    using Base       = detail::maybe_const<Const, V>;                   // exposition only
+    using Func       = detail::maybe_const<Const, F>;                   // exposition only
+    using ResultType = std::decay_t<                                    // exposition only
+        std::invoke_result_t<Func&, T, std::ranges::range_reference_t<Base> > >;
+
+    std::ranges::iterator_t<Base>             current_ = std::ranges::iterator_t<Base>();         // exposition only
+    detail::scan_iterator_holder<V, F, Const> parent_  = {};                                      // exposition only
+    detail::movable_box<ResultType>           sum_;                                               // exposition only
+    bool                                      done_    = K == exclusive_scan_kind::without_total; // exposition only
+
+    constexpr void fold(std::ranges::range_reference_t<Base> x) { // exposition only
+        if constexpr (detail::accumulates_in_place<Func, ResultType, std::ranges::range_reference_t<Base> >)
+            parent_.fun().accumulate(*sum_, std::forward<std::ranges::range_reference_t<Base> >(x));
+        else
+            sum_ = detail::movable_box<ResultType>{
+                std::in_place,
+                std::invoke(parent_.fun(), std::move(*sum_), std::forward<std::ranges::range_reference_t<Base> >(x))};
+    }
+
+    friend class iterator<!Const>;
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = ResultType;
+    using difference_type  = std::ranges::range_difference_t<Base>;
+
+    iterator()
+        requires std::default_initializable<std::ranges::iterator_t<Base> >
+    = default;
+    constexpr iterator(Parent& parent, std::ranges::iterator_t<Base> current)
+        : current_{std::move(current)},
+          parent_{std::ranges::end(parent.base_), *parent.fun_},
+          sum_{std::in_place, detail::seed_copy(*parent.init_)} {}
+    constexpr iterator(iterator<!Const> i)
+        requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base> > &&
+                 std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<Base> >
+        : current_{std::move(i.current_)},
+          parent_{std::move(i.parent_)},
+          sum_{std::move(i.sum_)},
+          done_{i.done_} {}
+
+    constexpr const std::ranges::iterator_t<Base>& base() const& noexcept { return current_; }
+    constexpr std::ranges::iterator_t<Base>        base() && { return std::move(current_); }
+
+    constexpr const value_type& operator*() const { return *sum_; }
+
+    // Without the total, the fold with the last element would never be observed. A forward iterator is advanced
+    // first so that this fold is skipped; an input iterator cannot look ahead without giving up the element.
+    constexpr iterator& operator++() {
+        if constexpr (K == exclusive_scan_kind::with_total) {
+            if (current_ == parent_.end()) {
+                done_ = true;
+                return *this;
+            }
+        }
+        if constexpr (K == exclusive_scan_kind::without_total &&
+                      std::forward_iterator<std::ranges::iterator_t<Base> >) {
+            const auto previous = current_;
+            if (++current_ != parent_.end())
+                fold(*previous);
+        } else {
+            fold(*current_);
+            ++current_;
+        }
+        return *this;
+    }
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& x, const iterator& y)
+        requires std::equality_comparable<std::ranges::iterator_t<Base> >
+    {
+        return x.current_ == y.current_ && x.done_ == y.done_;
+    }
+    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) {
+        return x.done_ && x.current_ == x.parent_.end();
+    }
+};
+
+namespace detail {
+
+template <exclusive_scan_kind K>
+struct exclusive_scan_t {
+    constexpr exclusive_scan_t() = default;
+    constexpr auto operator()(std::ranges::input_range auto&& E, auto&& F, auto&& G) const {
+        return exclusive_scan_view<std::views::all_t<decltype(E)>,
+                                   std::decay_t<decltype(F)>,
+                                   std::decay_t<decltype(G)>,
+                                   K>{std::views::all(std::forward<decltype(E)>(E)),
+                                      std::forward<decltype(F)>(F),
+                                      std::forward<decltype(G)>(G)};
+    }
+
+    constexpr auto operator()(auto&& E, auto&& F) const {
+        return detail::range_adaptor_closure_t(
+            detail::bind_back(*this, std::forward<decltype(E)>(E), std::forward<decltype(F)>(F)));
+    }
+};
+
+} // namespace detail
+
+inline constexpr detail::exclusive_scan_t<exclusive_scan_kind::without_total> exclusive_scan{};
+inline constexpr detail::exclusive_scan_t<exclusive_scan_kind::with_total>    exclusive_scan_with_total{};
+
+// Computes bucket offsets for the integral keys in `keys`: after the call, `offsets[b]` is the number of keys less
+// than `b` and `offsets[std::ranges::size(offsets) - 1]` is the number of keys. This is the row-pointer array of a
+// CSR matrix, or the scatter offsets of a counting/radix partitioning pass. Every key must lie in
+// `[0, std::ranges::size(offsets) - 1)`. Returns an iterator past the last offset written.
+template <std::ranges::input_range Keys, std::ranges::random_access_range Offsets>
+    requires std::integral<std::ranges::range_value_t<Keys> > &&
+             std::integral<std::ranges::range_value_t<Offsets> > && std::ranges::sized_range<Offsets> &&
+             std::ranges::output_range<Offsets, std::ranges::range_value_t<Offsets> >
+constexpr std::ranges::borrowed_iterator_t<Offsets> histogram_offsets(Keys&& keys, Offsets&& offsets) {
+    using Count = std::ranges::range_value_t<Offsets>;
+
+    const auto first = std::ranges::begin(offsets);
+    const auto n     = std::ranges::distance(offsets);
+    if (n == 0)
+        return first;
+    std::ranges::fill(first, first + n, Count{0});
+    // Count each key one slot to the right, so that the in-place inclusive scan below leaves the exclusive scan with
+    // total of the counts in `offsets`.
+    for (auto&& key : keys)
+        ++first[static_cast<std::ranges::range_difference_t<Offsets> >(key) + 1];
+    Count sum = 0;
+    for (auto it = first + 1; it != first + n; ++it)
+        *it = sum += *it;
+    return first + n;
+}
+
+} // namespace beman::scan_view
+
+template <std::ranges::input_range              V,
+          std::move_constructible               F,
+          std::move_constructible               T,
+          beman::scan_view::exclusive_scan_kind K>
+constexpr bool std::ranges::enable_borrowed_range<beman::scan_view::exclusive_scan_view<V, F, T, K> > =
+    std::ranges::enable_borrowed_range<V> && beman::scan_view::detail::tidy_func<F>;
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_EXCLUSIVE_SCAN_HPP
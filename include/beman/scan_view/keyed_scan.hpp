@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_KEYED_SCAN_HPP
+#define BEMAN_SCAN_VIEW_KEYED_SCAN_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <bit>
+        #include <concepts>
+        #include <cstddef>
+        #include <cstdint>
+        #include <functional>
+        #include <memory>
+        #include <ranges>
+        #include <type_traits>
+        #include <utility>
+        #include <vector>
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+    #include "scan.hpp"
+
+namespace beman::scan_view {
+
+// Tuning of the per-key table of a `keyed_scan_view`.
+struct keyed_scan_options {
+    // Expected number of distinct keys; the table is sized for it up front instead of growing.
+    std::size_t capacity_hint = 0;
+    // If non-zero, at most this many keys are tracked. A new key then evicts a tracked key near its own slot, and an
+    // evicted key starts again from the initial value when it reappears.
+    std::size_t max_keys = 0;
+};
+
+namespace detail {
+
+// An open-addressing hash table with linear probing. The slots are one contiguous array next to an array of control
+// bytes holding a 7-bit fingerprint of each occupied slot, so a lookup usually touches one cache line of each. It is
+// a non-propagating cache: copies start out empty.
+template <class Key, class Value>
+class flat_table { // exposition only
+    struct slot {
+        Key   key;
+        Value value;
+    };
+
+    std::allocator<slot>      alloc_;
+    slot*                     slots_ = nullptr;
+    std::vector<std::uint8_t> ctrl_;
+    std::size_t               mask_     = 0;
+    unsigned                  shift_    = 64;
+    std::size_t               size_     = 0;
+    std::size_t               max_size_ = 0;
+
+    static constexpr std::size_t min_capacity = 8;
+
+    constexpr std::size_t capacity() const noexcept { return ctrl_.size(); }
+    constexpr std::size_t home(std::uint64_t h) const noexcept { return static_cast<std::size_t>(h >> shift_); }
+    static constexpr std::uint8_t fingerprint(std::uint64_t h) noexcept {
+        return static_cast<std::uint8_t>(0x80u | ((h >> 25) & 0x7fu));
+    }
+
+    constexpr void destroy() noexcept {
+        if (slots_ == nullptr)
+            return;
+        for (std::size_t i = 0; i < capacity(); ++i)
+            if (ctrl_[i] != 0)
+                std::destroy_at(slots_ + i);
+        alloc_.deallocate(slots_, capacity());
+        slots_ = nullptr;
+        ctrl_.clear();
+        size_ = 0;
+    }
+
+    constexpr void allocate(std::size_t capacity) {
+        slots_ = alloc_.allocate(capacity);
+        ctrl_.assign(capacity, 0);
+        mask_  = capacity - 1;
+        shift_ = 64 - static_cast<unsigned>(std::countr_zero(capacity));
+    }
+
+    // Places a slot whose key is known to be absent, without checking the load factor.
+    constexpr slot& place(std::uint64_t h, Key&& key, Value&& value) {
+        std::size_t i = home(h);
+        while (ctrl_[i] != 0)
+            i = (i + 1) & mask_;
+        std::construct_at(slots_ + i, slot{std::move(key), std::move(value)});
+        ctrl_[i] = fingerprint(h);
+        ++size_;
+        return slots_[i];
+    }
+
+    constexpr void grow() {
+        slot* const               old_slots = slots_;
+        std::vector<std::uint8_t> old_ctrl  = std::move(ctrl_);
+        allocate(old_ctrl.size() * 2);
+        size_ = 0;
+        for (std::size_t i = 0; i < old_ctrl.size(); ++i) {
+            if (old_ctrl[i] != 0) {
+                place(hash(old_slots[i].key), std::move(old_slots[i].key), std::move(old_slots[i].value));
+                std::destroy_at(old_slots + i);
+            }
+        }
+        alloc_.deallocate(old_slots, old_ctrl.size());
+    }
+
+    // Removes the slot at `i` and shifts the following slots of the cluster back, so no tombstones are needed.
+    constexpr void erase_at(std::size_t i) {
+        std::destroy_at(slots_ + i);
+        ctrl_[i] = 0;
+        --size_;
+        for (std::size_t j = (i + 1) & mask_; ctrl_[j] != 0; j = (j + 1) & mask_) {
+            const std::size_t k = home(hash(slots_[j].key));
+            // Move the slot at `j` into the hole unless its home lies cyclically in (i, j].
+            if (((j - k) & mask_) >= ((j - i) & mask_)) {
+                std::construct_at(slots_ + i, std::move(slots_[j]));
+                ctrl_[i] = ctrl_[j];
+                std::destroy_at(slots_ + j);
+                ctrl_[j] = 0;
+                i        = j;
+            }
+        }
+    }
+
+  public:
+    flat_table() = default;
+    flat_table(const flat_table&) noexcept {}
+    constexpr flat_table(flat_table&& other) noexcept
+        : slots_{std::exchange(other.slots_, nullptr)},
+          ctrl_{std::move(other.ctrl_)},
+          mask_{other.mask_},
+          shift_{other.shift_},
+          size_{std::exchange(other.size_, 0)},
+          max_size_{other.max_size_} {
+        other.ctrl_.clear();
+    }
+    constexpr flat_table& operator=(const flat_table& other) noexcept {
+        if (this != std::addressof(other))
+            destroy();
+        return *this;
+    }
+    constexpr flat_table& operator=(flat_table&& other) noexcept {
+        if (this != std::addressof(other)) {
+            destroy();
+            slots_    = std::exchange(other.slots_, nullptr);
+            ctrl_     = std::move(other.ctrl_);
+            mask_     = other.mask_;
+            shift_    = other.shift_;
+            size_     = std::exchange(other.size_, 0);
+            max_size_ = other.max_size_;
+            other.ctrl_.clear();
+        }
+        return *this;
+    }
+    constexpr ~flat_table() { destroy(); }
+
+    static constexpr std::uint64_t hash(const Key& key) {
+        // Fibonacci hashing spreads the identity hashes of integral keys over the high bits used for the index.
+        return static_cast<std::uint64_t>(std::hash<Key>{}(key)) * 0x9e3779b97f4a7c15ull;
+    }
+
+    // Empties the table and sizes it for `options`.
+    constexpr void reset(const keyed_scan_options& options) {
+        destroy();
+        max_size_            = options.max_keys;
+        const std::size_t n  = max_size_ != 0 ? max_size_ : options.capacity_hint;
+        const std::size_t lf = n + n / 7 + 1; // keeps the load factor at or below 7/8
+        allocate(std::bit_ceil(lf < min_capacity ? min_capacity : lf));
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+
+    constexpr Value* find(const Key& key, std::uint64_t h) noexcept {
+        const std::uint8_t fp = fingerprint(h);
+        for (std::size_t i = home(h); ctrl_[i] != 0; i = (i + 1) & mask_)
+            if (ctrl_[i] == fp && slots_[i].key == key)
+                return std::addressof(slots_[i].value);
+        return nullptr;
+    }
+
+    // Inserts a key that `find` did not find, evicting or growing as configured.
+    constexpr Value& insert(Key&& key, std::uint64_t h, Value&& value) {
+        if (max_size_ != 0 && size_ >= max_size_) {
+            std::size_t victim = home(h);
+            while (ctrl_[victim] == 0)
+                victim = (victim + 1) & mask_;
+            erase_at(victim);
+        } else if ((size_ + 1) * 8 > capacity() * 7) {
+            grow();
+        }
+        return place(h, std::move(key), std::move(value)).value;
+    }
+};
+
+template <class KeyFn, class V>
+concept key_extractor = // exposition only
+    std::regular_invocable<KeyFn&, std::ranges::range_reference_t<V> > &&
+    requires(const std::decay_t<std::invoke_result_t<KeyFn&, std::ranges::range_reference_t<V> > >& key) {
+        { key == key } -> std::convertible_to<bool>;
+        { std::hash<std::remove_cvref_t<decltype(key)> >{}(key) } -> std::convertible_to<std::size_t>;
+    };
+
+} // namespace detail
+
+// A scan per key: for each element `x` with key `k = key_fn(x)`, the view produces the fold of all elements with key
+// `k` up to and including `x`, whatever the order of the keys. The running values live in a flat hash table owned by
+// the view, which is cleared by `begin()`; the view is therefore not const-iterable.
+template <std::ranges::input_range V,
+          std::move_constructible  KeyFn,
+          std::move_constructible  F,
+          std::move_constructible  T,
+          scan_view_kind           K = scan_view_kind::unseeded>
+    requires std::ranges::view<V> && std::is_object_v<KeyFn> && std::is_object_v<F> && std::is_object_v<T> &&
+             detail::key_extractor<KeyFn, V> && scannable<V, F, T, K>
+class keyed_scan_view : public std::ranges::view_interface<keyed_scan_view<V, KeyFn, F, T, K> > {
+  private:
+    class iterator; // exposition only
+
+    using Key = std::decay_t<std::invoke_result_t<KeyFn&, std::ranges::range_reference_t<V> > >; // exposition only
+    using ResultType =                                                                           // exposition only
+        std::decay_t<std::invoke_result_t<F&, T, std::ranges::range_reference_t<V> > >;
+
+    V                                   base_ = V(); // exposition only
+    detail::movable_box<KeyFn>          key_fn_;     // exposition only
+    detail::movable_box<F>              fun_;        // exposition only
+    detail::movable_box<T>              init_;       // exposition only
+    keyed_scan_options                  options_;    // exposition only
+    detail::flat_table<Key, ResultType> table_;      // exposition only
+
+  public:
+    keyed_scan_view()
+        requires std::default_initializable<V> && std::default_initializable<KeyFn> && std::default_initializable<F>
+    = default;
+    constexpr explicit keyed_scan_view(V base, KeyFn key_fn, F fun, keyed_scan_options options = {})
+        requires(K == scan_view_kind::unseeded)
+        : base_{std::move(base)},
+          key_fn_{std::in_place, std::move(key_fn)},
+          fun_{std::in_place, std::move(fun)},
+          options_{options} {}
+    constexpr explicit keyed_scan_view(V base, KeyFn key_fn, F fun, T init, keyed_scan_options options = {})
+        requires(K == scan_view_kind::seeded)
+        : base_{std::move(base)},
+          key_fn_{std::in_place, std::move(key_fn)},
+          fun_{std::in_place, std::move(fun)},
+          init_{std::in_place, std::move(init)},
+          options_{options} {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr iterator begin() {
+        table_.reset(options_);
+        return iterator{*this, std::ranges::begin(base_)};
+    }
+
+    [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    constexpr auto size()
+        requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(base_);
+    }
+    constexpr auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        return std::ranges::size(base_);
+    }
+};
+
+template <class R, class KeyFn, class F>
+keyed_scan_view(R&&, KeyFn, F) -> keyed_scan_view<std::views::all_t<R>, KeyFn, F, std::ranges::range_value_t<R> >;
+template <class R, class KeyFn, class F>
+keyed_scan_view(R&&, KeyFn, F, keyed_scan_options)
+    -> keyed_scan_view<std::views::all_t<R>, KeyFn, F, std::ranges::range_value_t<R> >;
+template <class R, class KeyFn, class F, class T>
+keyed_scan_view(R&&, KeyFn, F, T) -> keyed_scan_view<std::views::all_t<R>, KeyFn, F, T, scan_view_kind::seeded>;
+template <class R, class KeyFn, class F, class T>
+keyed_scan_view(R&&, KeyFn, F, T, keyed_scan_options)
+    -> keyed_scan_view<std::views::all_t<R>, KeyFn, F, T, scan_view_kind::seeded>;
+
+template <std::ranges::input_range V,
+          std::move_constructible  KeyFn,
+          std::move_constructible  F,
+          std::move_constructible  T,
+          scan_view_kind           K>
+    requires std::ranges::view<V> && std::is_object_v<KeyFn> && std::is_object_v<F> && std::is_object_v<T> &&
+             detail::key_extractor<KeyFn, V> && scannable<V, F, T, K>
+class keyed_scan_view<V, KeyFn, F, T, K>::iterator {
+  private:
+    std::ranges::iterator_t<V> current_ = std::ranges::iterator_t<V>(); // exposition only
+    std::ranges::sentinel_t<V> end_     = std::ranges::sentinel_t<V>(); // exposition only
+    keyed_scan_view*           parent_  = nullptr;                      // exposition only
+    ResultType*                value_   = nullptr;                      // exposition only
+
+    constexpr void update() { // exposition only
+        auto&& x = *current_;
+        // The lookup goes through whatever the key function returns, e.g. a reference to a member of the element; a
+        // `Key` is only materialized for a new key. It is constructed before `x` is passed on to `fun_`, which may
+        // move from it.
+        auto&&              key = std::invoke(*parent_->key_fn_, x);
+        const std::uint64_t h   = parent_->table_.hash(key);
+        if (ResultType* v = parent_->table_.find(key, h)) {
+            if constexpr (detail::accumulates_in_place<F, ResultType, decltype(x)>)
+                parent_->fun_->accumulate(*v, std::forward<decltype(x)>(x));
+            else
+                *v = std::invoke(*parent_->fun_, std::move(*v), std::forward<decltype(x)>(x));
+            value_ = v;
+        } else {
+            Key new_key(std::forward<decltype(key)>(key));
+            if constexpr (K == scan_view_kind::seeded)
+                value_ = std::addressof(parent_->table_.insert(
+                    std::move(new_key),
+                    h,
+                    std::invoke(*parent_->fun_, detail::seed_copy(*parent_->init_), std::forward<decltype(x)>(x))));
+            else
+                value_ = std::addressof(
+                    parent_->table_.insert(std::move(new_key), h, ResultType(std::forward<decltype(x)>(x))));
+        }
+    }
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = ResultType;
+    using difference_type  = std::ranges::range_difference_t<V>;
+
+    iterator()
+        requires std::default_initializable<std::ranges::iterator_t<V> >
+    = default;
+    constexpr iterator(keyed_scan_view& parent, std::ranges::iterator_t<V> current)
+        : current_{std::move(current)}, end_{std::ranges::end(parent.base_)}, parent_{std::addressof(parent)} {
+        if (current_ != end_)
+            update();
+    }
+
+    constexpr const std::ranges::iterator_t<V>& base() const& noexcept { return current_; }
+    constexpr std::ranges::iterator_t<V>        base() && { return std::move(current_); }
+
+    constexpr const value_type& operator*() const noexcept { return *value_; }
+
+    constexpr iterator& operator++() {
+        if (++current_ != end_)
+            update();
+        return *this;
+    }
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) { return x.current_ == x.end_; }
+};
+
+namespace detail {
+
+struct keyed_scan_t {
+    constexpr keyed_scan_t() = default;
+    constexpr auto operator()(std::ranges::input_range auto&& E, auto&& KeyFn, auto&& F) const {
+        return keyed_scan_view{std::forward<decltype(E)>(E),
+                               std::forward<decltype(KeyFn)>(KeyFn),
+                               std::forward<decltype(F)>(F)};
+    }
+    constexpr auto operator()(std::ranges::input_range auto&& E, auto&& KeyFn, auto&& F, auto&& G) const {
+        return keyed_scan_view{std::forward<decltype(E)>(E),
+                               std::forward<decltype(KeyFn)>(KeyFn),
+                               std::forward<decltype(F)>(F),
+                               std::forward<decltype(G)>(G)};
+    }
+
+    constexpr auto operator()(auto&& KeyFn, auto&& F) const {
+        return detail::range_adaptor_closure_t(
+            detail::bind_back(*this, std::forward<decltype(KeyFn)>(KeyFn), std::forward<decltype(F)>(F)));
+    }
+    constexpr auto operator()(auto&& KeyFn, auto&& F, auto&& G) const
+        requires(!std::ranges::input_range<decltype(KeyFn)>)
+    {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this,
+                                                                 std::forward<decltype(KeyFn)>(KeyFn),
+                                                                 std::forward<decltype(F)>(F),
+                                                                 std::forward<decltype(G)>(G)));
+    }
+};
+
+} // namespace detail
+
+// `r | keyed_scan(key_fn, f)` and `r | keyed_scan(key_fn, f, init)` produce, for each element, the updated running
+// value of its key. Use the `keyed_scan_view` constructors to pass `keyed_scan_options`.
+inline constexpr detail::keyed_scan_t keyed_scan{};
+
+} // namespace beman::scan_view
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_KEYED_SCAN_HPP
@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_LINEAR_RECURRENCE_HPP
+#define BEMAN_SCAN_VIEW_LINEAR_RECURRENCE_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <algorithm>
+        #include <cmath>
+        #include <concepts>
+        #include <ranges>
+        #include <type_traits>
+        #include <utility>
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+
+namespace beman::scan_view {
+
+namespace detail {
+
+template <class T>
+concept affine_value = // exposition only
+    std::copyable<T> && requires(const T& x) {
+        { x * x + x } -> std::convertible_to<T>;
+    };
+
+// Whether `std::fma` is a fused multiply-add instruction for `T`. Otherwise it is a library call that emulates the
+// single rounding, much slower than a multiplication and an addition. The compiler's predefined `__FP_FAST_FMA*`
+// macros are checked as well as those of `<cmath>`, which `import std;` does not provide.
+template <class T>
+inline constexpr bool fast_fma = false; // exposition only
+    #if defined(FP_FAST_FMAF) || defined(__FP_FAST_FMAF)
+template <>
+inline constexpr bool fast_fma<float> = true; // exposition only
+    #endif
+    #if defined(FP_FAST_FMA) || defined(__FP_FAST_FMA)
+template <>
+inline constexpr bool fast_fma<double> = true; // exposition only
+    #endif
+    #if defined(FP_FAST_FMAL) || defined(__FP_FAST_FMAL)
+template <>
+inline constexpr bool fast_fma<long double> = true; // exposition only
+    #endif
+
+// `a * x + b`, with a single rounding for floating-point types that have a fused multiply-add instruction when not
+// constant-evaluated.
+template <affine_value T>
+constexpr T mul_add(const T& a, const T& x, const T& b) {
+    if constexpr (fast_fma<T>) {
+        if (!std::is_constant_evaluated())
+            return std::fma(a, x, b);
+    }
+    return a * x + b;
+}
+
+} // namespace detail
+
+// The affine map `y -> a * y + b`. The composition of affine maps is again an affine map and composition is
+// associative, which is what lets a linear recurrence `y[i] = a[i] * y[i - 1] + b[i]` be evaluated by any scan
+// algorithm that may reassociate, not only by a left fold.
+template <detail::affine_value T>
+struct affine {
+    T a = T(1);
+    T b = T(0);
+
+    constexpr T operator()(const T& y) const { return detail::mul_add(a, y, b); }
+
+    friend constexpr bool operator==(const affine&, const affine&) = default;
+};
+
+template <class T>
+affine(T, T) -> affine<T>;
+
+// Associative operation on affine maps: `affine_compose{}(f, g)` is the map that applies `f` and then `g`. It can be
+// passed as the binary operation of `std::inclusive_scan`/`std::reduce` with an execution policy, or of `scan`,
+// to obtain the prefix compositions of a sequence of maps; applying the i-th prefix to `y0` gives `y[i]`.
+struct affine_compose {
+    template <class T>
+    constexpr affine<T> operator()(const affine<T>& f, const affine<T>& g) const {
+        return {g.a * f.a, detail::mul_add(g.a, f.b, g.b)};
+    }
+};
+
+// One step of a linear recurrence: `affine_apply{}(y, f)` is `f(y)`. `scan(maps, affine_apply{}, y0)` is the lazy,
+// serial evaluation of the recurrence over a range of affine maps.
+struct affine_apply {
+    template <class T>
+    constexpr T operator()(const T& y, const affine<T>& f) const {
+        return f(y);
+    }
+};
+
+// The lazy view of the first-order linear recurrence `y[i] = a[i] * y[i - 1] + b[i]` with `y[-1] = y0`, over a range
+// of coefficients `a` and a range of offsets `b`. It has as many elements as the shorter of the two ranges.
+template <std::ranges::input_range A, std::ranges::input_range B, detail::affine_value T>
+    requires std::ranges::view<A> && std::ranges::view<B> &&
+             std::convertible_to<std::ranges::range_reference_t<A>, T> &&
+             std::convertible_to<std::ranges::range_reference_t<B>, T>
+class linear_recurrence_view : public std::ranges::view_interface<linear_recurrence_view<A, B, T> > {
+  private:
+    template <bool>
+    class iterator; // exposition only
+
+    template <bool>
+    friend class iterator; // exposition only
+
+    A a_  = A(); // exposition only
+    B b_  = B(); // exposition only
+    T y0_ = T(); // exposition only
+
+    template <class Self>
+    static constexpr auto size_impl(Self& self) { // exposition only
+        using CT = std::make_unsigned_t<std::common_type_t<decltype(std::ranges::size(self.a_)),
+                                                           decltype(std::ranges::size(self.b_))> >;
+        return std::ranges::min(static_cast<CT>(std::ranges::size(self.a_)),
+                                static_cast<CT>(std::ranges::size(self.b_)));
+    }
+
+  public:
+    linear_recurrence_view()
+        requires std::default_initializable<A> && std::default_initializable<B> && std::default_initializable<T>
+    = default;
+    constexpr explicit linear_recurrence_view(A a, B b, T y0)
+        : a_{std::move(a)}, b_{std::move(b)}, y0_{std::move(y0)} {}
+
+    constexpr iterator<false> begin() { return iterator<false>{*this}; }
+    constexpr iterator<true>  begin() const
+        requires std::ranges::input_range<const A> && std::ranges::input_range<const B> &&
+                 std::convertible_to<std::ranges::range_reference_t<const A>, T> &&
+                 std::convertible_to<std::ranges::range_reference_t<const B>, T>
+    {
+        return iterator<true>{*this};
+    }
+
+    [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    constexpr auto size()
+        requires std::ranges::sized_range<A> && std::ranges::sized_range<B>
+    {
+        return size_impl(*this);
+    }
+    constexpr auto size() const
+        requires std::ranges::sized_range<const A> && std::ranges::sized_range<const B>
+    {
+        return size_impl(*this);
+    }
+};
+
+template <class RA, class RB, class T>
+linear_recurrence_view(RA&&, RB&&, T) -> linear_recurrence_view<std::views::all_t<RA>, std::views::all_t<RB>, T>;
+
+template <std::ranges::input_range A, std::ranges::input_range B, detail::affine_value T>
+    requires std::ranges::view<A> && std::ranges::view<B> &&
+             std::convertible_to<std::ranges::range_reference_t<A>, T> &&
+             std::convertible_to<std::ranges::range_reference_t<B>, T>
+template <bool Const>
+class linear_recurrence_view<A, B, T>::iterator {
+  private:
+    using Parent = detail::maybe_const<Const, linear_recurrence_view>; // exposition only
+    using BaseA  = detail::maybe_const<Const, A>;                      // exposition only
+    using BaseB  = detail::maybe_const<Const, B>;                      // exposition only
+
+    std::ranges::iterator_t<BaseA> a_     = std::ranges::iterator_t<BaseA>(); // exposition only
+    std::ranges::iterator_t<BaseB> b_     = std::ranges::iterator_t<BaseB>(); // exposition only
+    std::ranges::sentinel_t<BaseA> a_end_ = std::ranges::sentinel_t<BaseA>(); // exposition only
+    std::ranges::sentinel_t<BaseB> b_end_ = std::ranges::sentinel_t<BaseB>(); // exposition only
+    T                              y_     = T();                              // exposition only
+
+    constexpr bool at_end() const { return a_ == a_end_ || b_ == b_end_; } // exposition only
+    constexpr void step() {                                                 // exposition only
+        y_ = detail::mul_add(static_cast<T>(*a_), y_, static_cast<T>(*b_));
+    }
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = T;
+    using difference_type  = std::common_type_t<std::ranges::range_difference_t<BaseA>,
+                                               std::ranges::range_difference_t<BaseB> >;
+
+    iterator()
+        requires std::default_initializable<std::ranges::iterator_t<BaseA> > &&
+                     std::default_initializable<std::ranges::iterator_t<BaseB> >
+    = default;
+    constexpr explicit iterator(Parent& parent)
+        : a_{std::ranges::begin(parent.a_)},
+          b_{std::ranges::begin(parent.b_)},
+          a_end_{std::ranges::end(parent.a_)},
+          b_end_{std::ranges::end(parent.b_)},
+          y_{parent.y0_} {
+        if (!at_end())
+            step();
+    }
+
+    constexpr const value_type& operator*() const noexcept { return y_; }
+
+    constexpr iterator& operator++() {
+        ++a_;
+        ++b_;
+        if (!at_end())
+            step();
+        return *this;
+    }
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& x, const iterator& y)
+        requires std::equality_comparable<std::ranges::iterator_t<BaseA> > &&
+                 std::equality_comparable<std::ranges::iterator_t<BaseB> >
+    {
+        return x.a_ == y.a_ && x.b_ == y.b_;
+    }
+    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) { return x.at_end(); }
+};
+
+namespace detail {
+
+struct linear_recurrence_t {
+    constexpr linear_recurrence_t() = default;
+    constexpr auto
+    operator()(std::ranges::input_range auto&& A, std::ranges::input_range auto&& B, auto&& Y0) const {
+        return linear_recurrence_view{
+            std::forward<decltype(A)>(A), std::forward<decltype(B)>(B), std::forward<decltype(Y0)>(Y0)};
+    }
+};
+
+} // namespace detail
+
+inline constexpr detail::linear_recurrence_t linear_recurrence{};
+
+} // namespace beman::scan_view
+
+template <std::ranges::input_range A, std::ranges::input_range B, beman::scan_view::detail::affine_value T>
+constexpr bool std::ranges::enable_borrowed_range<beman::scan_view::linear_recurrence_view<A, B, T> > =
+    std::ranges::enable_borrowed_range<A> && std::ranges::enable_borrowed_range<B>;
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_LINEAR_RECURRENCE_HPP
@@ -0,0 +1,360 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_MDSCAN_HPP
+#define BEMAN_SCAN_VIEW_MDSCAN_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <version>
+
+        #include <algorithm>
+        #include <concepts>
+        #include <cstddef>
+        #include <functional>
+        #include <iterator>
+        #include <ranges>
+        #include <type_traits>
+        #include <utility>
+        #include <vector>
+        #if defined(__cpp_lib_mdspan)
+            #include <mdspan>
+        #endif
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+
+namespace beman::scan_view {
+
+// Two-dimensional inclusive scans: element (i, j) of the result is the fold with `f` of the elements (r, c) of the
+// input with r <= i and c <= j, e.g. a summed-area table (integral image) for `std::plus`. Since the elements are not
+// folded in a fixed order, `f` must be associative and commutative.
+
+namespace detail {
+
+// Scans a `rows` x `cols` grid accessed through `in(i, j)` and `out(i, j)`, where consecutive `j` are adjacent in
+// memory, except that the last row has only `last_cols <= cols` columns. Each row is visited once: a row prefix pass,
+// whose dependency chain is the only sequential part, followed by an element-wise fold with the previous output row,
+// which vectorizes. Both passes run over blocks of columns that fit in the L1 cache, so the second pass reads the row
+// prefixes from cache. `in` and `out` may refer to the same elements.
+template <class T, class In, class Out, class F>
+constexpr void
+mdscan_rows(std::size_t rows, std::size_t cols, std::size_t last_cols, In in, Out out, F& f) { // exposition only
+    constexpr std::size_t block = std::max<std::size_t>(16 * 1024 / sizeof(T), 1);
+    for (std::size_t i = 0; i < rows; ++i) {
+        const std::size_t n = i + 1 == rows ? last_cols : cols;
+        if (n == 0)
+            return;
+        T carry   = static_cast<T>(in(i, 0));
+        out(i, 0) = carry;
+        for (std::size_t j0 = 0; j0 < n; j0 += block) {
+            const std::size_t j1 = std::min(n, j0 + block);
+            for (std::size_t j = std::max<std::size_t>(j0, 1); j < j1; ++j) {
+                carry     = std::invoke(f, std::move(carry), in(i, j));
+                out(i, j) = carry;
+            }
+            if (i != 0)
+                for (std::size_t j = j0; j < j1; ++j)
+                    out(i, j) = std::invoke(f, out(i - 1, j), out(i, j));
+        }
+    }
+}
+
+// The fold of the rectangle [row0, row1) x [col0, col1) from the four corners of a summed-area table `at(i, j)`.
+template <class T, class At>
+constexpr T rectangle_sum_impl(At at, std::size_t row0, std::size_t col0, std::size_t row1, std::size_t col1) {
+    if (row0 >= row1 || col0 >= col1)
+        return T();
+    T sum = at(row1 - 1, col1 - 1);
+    if (row0 != 0)
+        sum = sum - at(row0 - 1, col1 - 1);
+    if (col0 != 0)
+        sum = sum - at(row1 - 1, col0 - 1);
+    if (row0 != 0 && col0 != 0)
+        sum = sum + at(row0 - 1, col0 - 1);
+    return sum;
+}
+
+} // namespace detail
+
+// Writes the two-dimensional scan of the row-major `in`, which has `cols` columns, to `out`, which must have at least
+// as many elements. If the size of `in` is not a multiple of `cols`, its last row is partial and scanned as such.
+template <std::ranges::random_access_range In, std::ranges::random_access_range Out, class F = std::plus<> >
+    requires std::ranges::sized_range<In> && std::ranges::sized_range<Out> &&
+             std::ranges::output_range<Out, std::ranges::range_value_t<Out> > &&
+             std::convertible_to<std::ranges::range_reference_t<In>, std::ranges::range_value_t<Out> > &&
+             std::regular_invocable<F&, std::ranges::range_value_t<Out>, std::ranges::range_reference_t<In> > &&
+             std::regular_invocable<F&, std::ranges::range_value_t<Out>, std::ranges::range_value_t<Out> >
+constexpr void mdscan(In&& in, Out&& out, std::size_t cols, F f = {}) {
+    using T      = std::ranges::range_value_t<Out>;
+    const auto i = std::ranges::begin(in);
+    const auto o = std::ranges::begin(out);
+    using DI     = std::iter_difference_t<decltype(i)>;
+    using DO     = std::iter_difference_t<decltype(o)>;
+    const auto n = static_cast<std::size_t>(std::ranges::size(in));
+    detail::mdscan_rows<T>(
+        cols == 0 ? 0 : (n + cols - 1) / cols,
+        cols,
+        cols == 0 || n % cols == 0 ? cols : n % cols,
+        [i, cols](std::size_t r, std::size_t c) -> decltype(auto) { return i[static_cast<DI>(r * cols + c)]; },
+        [o, cols](std::size_t r, std::size_t c) -> decltype(auto) { return o[static_cast<DO>(r * cols + c)]; },
+        f);
+}
+
+// The fold of the rectangle [row0, row1) x [col0, col1) of the input of a row-major summed-area table `sat` with
+// `cols` columns, in O(1). The fold must be invertible through `-`, as for sums.
+template <std::ranges::random_access_range Sat>
+constexpr std::ranges::range_value_t<Sat> rectangle_sum(
+    Sat&& sat, std::size_t cols, std::size_t row0, std::size_t col0, std::size_t row1, std::size_t col1) {
+    const auto s = std::ranges::begin(sat);
+    using D      = std::iter_difference_t<decltype(s)>;
+    return detail::rectangle_sum_impl<std::ranges::range_value_t<Sat> >(
+        [s, cols](std::size_t r, std::size_t c) { return s[static_cast<D>(r * cols + c)]; }, row0, col0, row1, col1);
+}
+
+    #if defined(__cpp_lib_mdspan)
+
+// Writes the two-dimensional scan of `in` to `out`, which must have the same extents and may be `in` itself. Row-major
+// and column-major layouts are both traversed along contiguous elements.
+template <class T,
+          class InExtents,
+          class InLayout,
+          class InAccessor,
+          class U,
+          class OutExtents,
+          class OutLayout,
+          class OutAccessor,
+          class F = std::plus<> >
+    requires(InExtents::rank() == 2 && OutExtents::rank() == 2) &&
+            std::regular_invocable<F&, std::remove_cv_t<U>, typename InAccessor::reference> &&
+            std::regular_invocable<F&, std::remove_cv_t<U>, std::remove_cv_t<U> >
+constexpr void mdscan(std::mdspan<T, InExtents, InLayout, InAccessor>     in,
+                      std::mdspan<U, OutExtents, OutLayout, OutAccessor> out,
+                      F                                                  f = {}) {
+    using V = std::remove_cv_t<U>;
+    if constexpr (std::is_same_v<InLayout, std::layout_left> && std::is_same_v<OutLayout, std::layout_left>) {
+        // The scan of the transpose is the transpose of the scan.
+        detail::mdscan_rows<V>(
+            out.extent(1),
+            out.extent(0),
+            out.extent(0),
+            [&in](std::size_t r, std::size_t c) -> decltype(auto) { return in[c, r]; },
+            [&out](std::size_t r, std::size_t c) -> decltype(auto) { return out[c, r]; },
+            f);
+    } else {
+        detail::mdscan_rows<V>(
+            out.extent(0),
+            out.extent(1),
+            out.extent(1),
+            [&in](std::size_t r, std::size_t c) -> decltype(auto) { return in[r, c]; },
+            [&out](std::size_t r, std::size_t c) -> decltype(auto) { return out[r, c]; },
+            f);
+    }
+}
+
+// The fold of the rectangle [row0, row1) x [col0, col1) of the input of the summed-area table `sat`, in O(1). The fold
+// must be invertible through `-`, as for sums.
+template <class T, class Extents, class Layout, class Accessor>
+    requires(Extents::rank() == 2)
+constexpr std::remove_cv_t<T> rectangle_sum(std::mdspan<T, Extents, Layout, Accessor> sat,
+                                            std::size_t                               row0,
+                                            std::size_t                               col0,
+                                            std::size_t                               row1,
+                                            std::size_t                               col1) {
+    return detail::rectangle_sum_impl<std::remove_cv_t<T> >(
+        [&sat](std::size_t r, std::size_t c) { return sat[r, c]; }, row0, col0, row1, col1);
+}
+
+    #endif // defined(__cpp_lib_mdspan)
+
+namespace detail {
+
+// The type of the running folds of a `summed_area_view`, derived from `f` as in `scan_view`: with `std::plus<>`, an
+// 8-bit image is summed in `int`.
+template <class V, class F>
+using area_result_t = // exposition only
+    std::decay_t<std::invoke_result_t<F&, std::ranges::range_value_t<V>, std::ranges::range_reference_t<V> > >;
+
+template <class V, class F, class T>
+concept area_scannable_impl = // exposition only
+    std::movable<T> && std::constructible_from<T, std::ranges::range_reference_t<V> > &&
+    std::regular_invocable<F&, T, std::ranges::range_reference_t<V> > && std::regular_invocable<F&, T, T> &&
+    std::assignable_from<T&, std::invoke_result_t<F&, T, std::ranges::range_reference_t<V> > > &&
+    std::assignable_from<T&, std::invoke_result_t<F&, T, T> >;
+
+} // namespace detail
+
+template <class V, class F>
+concept area_scannable = // exposition only
+    std::ranges::input_range<V> &&
+    std::regular_invocable<F&, std::ranges::range_value_t<V>, std::ranges::range_reference_t<V> > &&
+    detail::area_scannable_impl<V, F, detail::area_result_t<V, F> >;
+
+// The two-dimensional scan of the row-major grid `base` with `cols` columns, produced lazily in row-major order. The
+// values have the result type of `f`, as for `scan_view`. Its iterators keep the previous output row, so the input is
+// read once and may be an input range.
+template <std::ranges::input_range V, std::move_constructible F>
+    requires std::ranges::view<V> && std::is_object_v<F> && area_scannable<V, F>
+class summed_area_view : public std::ranges::view_interface<summed_area_view<V, F> > {
+  private:
+    template <bool Const>
+    class iterator; // exposition only
+
+    V                      base_ = V(); // exposition only
+    std::size_t            cols_ = 1;   // exposition only
+    detail::movable_box<F> fun_;        // exposition only
+
+  public:
+    summed_area_view()
+        requires std::default_initializable<V> && std::default_initializable<F>
+    = default;
+    constexpr explicit summed_area_view(V base, std::size_t cols, F fun)
+        : base_{std::move(base)}, cols_{cols}, fun_{std::in_place, std::move(fun)} {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+    constexpr V base() && { return std::move(base_); }
+
+    [[nodiscard]] constexpr std::size_t columns() const noexcept { return cols_; }
+
+    constexpr iterator<false> begin() { return iterator<false>{*this, std::ranges::begin(base_)}; }
+    constexpr iterator<true>  begin() const
+        requires std::ranges::input_range<const V> && area_scannable<const V, const F>
+    {
+        return iterator<true>{*this, std::ranges::begin(base_)};
+    }
+
+    [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    constexpr auto size()
+        requires std::ranges::sized_range<V>
+    {
+        return std::ranges::size(base_);
+    }
+    constexpr auto size() const
+        requires std::ranges::sized_range<const V>
+    {
+        return std::ranges::size(base_);
+    }
+};
+
+template <class R, class F>
+summed_area_view(R&&, std::size_t, F) -> summed_area_view<std::views::all_t<R>, F>;
+
+template <std::ranges::input_range V, std::move_constructible F>
+    requires std::ranges::view<V> && std::is_object_v<F> && area_scannable<V, F>
+template <bool Const>
+class summed_area_view<V, F>::iterator {
+  private:
+    friend class iterator<!Const>;
+
+    using Parent     = detail::maybe_const<Const, summed_area_view>; // exposition only
+    using Base       = detail::maybe_const<Const, V>;                // exposition only
+    using ResultType = detail::area_result_t<Base, F>;               // exposition only
+
+    std::ranges::iterator_t<Base>   current_ = std::ranges::iterator_t<Base>(); // exposition only
+    std::ranges::sentinel_t<Base>   end_     = std::ranges::sentinel_t<Base>(); // exposition only
+    Parent*                         parent_  = nullptr;                         // exposition only
+    std::size_t                     col_     = 0;                               // exposition only
+    detail::movable_box<ResultType> carry_;                                     // exposition only
+    std::vector<ResultType>         prev_;                                      // exposition only
+
+    constexpr void update() { // exposition only
+        auto&& x = *current_;
+        if (col_ == 0)
+            carry_ = detail::movable_box<ResultType>{std::in_place, std::forward<decltype(x)>(x)};
+        else
+            carry_ = detail::movable_box<ResultType>{
+                std::in_place, std::invoke(*parent_->fun_, std::move(*carry_), std::forward<decltype(x)>(x))};
+        if (prev_.size() == col_)
+            prev_.push_back(*carry_);
+        else
+            prev_[col_] = std::invoke(*parent_->fun_, std::move(prev_[col_]), *carry_);
+    }
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = ResultType;
+    using difference_type  = std::ranges::range_difference_t<Base>;
+
+    iterator()
+        requires std::default_initializable<std::ranges::iterator_t<Base> >
+    = default;
+    constexpr iterator(Parent& parent, std::ranges::iterator_t<Base> current)
+        : current_{std::move(current)}, end_{std::ranges::end(parent.base_)}, parent_{std::addressof(parent)} {
+        prev_.reserve(parent.cols_);
+        if (current_ != end_)
+            update();
+    }
+    constexpr iterator(iterator<!Const> i)
+        requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base> > &&
+                 std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<Base> >
+        : current_{std::move(i.current_)},
+          end_{std::move(i.end_)},
+          parent_{i.parent_},
+          col_{i.col_},
+          carry_{std::move(i.carry_)},
+          prev_{std::move(i.prev_)} {}
+
+    constexpr const std::ranges::iterator_t<Base>& base() const& noexcept { return current_; }
+    constexpr std::ranges::iterator_t<Base>        base() && { return std::move(current_); }
+
+    constexpr const value_type& operator*() const { return prev_[col_]; }
+
+    // The column of the current element within its row.
+    [[nodiscard]] constexpr std::size_t column() const noexcept { return col_; }
+
+    constexpr iterator& operator++() {
+        if (++col_ == parent_->cols_)
+            col_ = 0;
+        if (++current_ != end_)
+            update();
+        return *this;
+    }
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) { return x.current_ == x.end_; }
+};
+
+namespace detail {
+
+struct summed_area_t {
+    constexpr summed_area_t() = default;
+    constexpr auto operator()(std::ranges::input_range auto&& E, std::size_t cols, auto&& F) const {
+        return summed_area_view{std::forward<decltype(E)>(E), cols, std::forward<decltype(F)>(F)};
+    }
+    constexpr auto operator()(std::ranges::input_range auto&& E, std::size_t cols) const {
+        return summed_area_view{std::forward<decltype(E)>(E), cols, std::plus<>{}};
+    }
+
+    constexpr auto operator()(std::size_t cols, auto&& F) const {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this, cols, std::forward<decltype(F)>(F)));
+    }
+    constexpr auto operator()(std::size_t cols) const {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this, cols));
+    }
+};
+
+} // namespace detail
+
+// `r | summed_area(cols)` and `r | summed_area(cols, f)` lazily produce the two-dimensional scan of the row-major grid
+// `r` with `cols` columns; `cols` must be positive.
+inline constexpr detail::summed_area_t summed_area{};
+
+} // namespace beman::scan_view
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_MDSCAN_HPP
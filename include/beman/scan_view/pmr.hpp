@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_PMR_HPP
+#define BEMAN_SCAN_VIEW_PMR_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <cstddef>
+        #include <memory>
+        #include <memory_resource>
+        #include <ranges>
+        #include <utility>
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+    #include "scan.hpp"
+
+namespace beman::scan_view {
+
+// A monotonic memory resource whose first `Bytes` bytes live inside the object, falling back to `upstream` once they
+// are exhausted. Deallocation is a no-op and everything is released when the arena is destroyed, which suits the
+// short-lived accumulators of a scan whose lifetime is bounded, e.g. one per batch or request.
+template <std::size_t Bytes>
+class scan_arena : public std::pmr::monotonic_buffer_resource {
+    alignas(std::max_align_t) std::byte buffer_[Bytes];
+
+  public:
+    explicit scan_arena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : std::pmr::monotonic_buffer_resource(buffer_, Bytes, upstream) {}
+};
+
+namespace detail {
+
+struct scan_with_allocator_t {
+    constexpr scan_with_allocator_t() = default;
+    template <std::ranges::input_range R, class F, class T, class Alloc>
+    constexpr auto operator()(R&& r, F&& f, const T& init, const Alloc& alloc) const {
+        return scan(std::forward<R>(r), std::forward<F>(f), std::make_obj_using_allocator<T>(alloc, init));
+    }
+
+    template <class F, class T, class Alloc>
+    constexpr auto operator()(F&& f, const T& init, const Alloc& alloc) const {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this, std::forward<F>(f), init, alloc));
+    }
+};
+
+} // namespace detail
+
+// `r | scan_with_allocator(f, init, alloc)` is a seeded scan whose initial value is a copy of `init` made by
+// uses-allocator construction with `alloc` (an allocator or a `std::pmr::memory_resource*`). Since the scan keeps the
+// allocator of its initial value, accumulators that `f` grows in place (strings, vectors, maps) allocate from `alloc`
+// rather than from the global heap.
+inline constexpr detail::scan_with_allocator_t scan_with_allocator{};
+
+} // namespace beman::scan_view
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_PMR_HPP
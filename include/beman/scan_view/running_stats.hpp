@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_RUNNING_STATS_HPP
+#define BEMAN_SCAN_VIEW_RUNNING_STATS_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <algorithm>
+        #include <array>
+        #include <bit>
+        #include <cmath>
+        #include <concepts>
+        #include <cstddef>
+        #include <cstdint>
+        #include <functional>
+        #include <limits>
+        #include <ranges>
+        #include <type_traits>
+        #include <utility>
+        #include <vector>
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+    #include "scan.hpp"
+
+namespace beman::scan_view {
+
+// Running statistics are small state types with two operations: `update(x)` folds in one element and `merge(other)`
+// folds in the state of another part of the input, so that states computed in parallel can be combined. Scan them
+// with `r | running_stat(state)`, and combine them with `stat_merge`, e.g. as the operation of `std::reduce`.
+
+// Mean and variance by Welford's algorithm, merged by the pairwise formula of Chan et al.
+template <std::floating_point T = double>
+class mean_variance {
+    std::uint64_t count_ = 0;
+    T             mean_  = 0;
+    T             m2_    = 0;
+
+  public:
+    constexpr void update(T x) noexcept {
+        ++count_;
+        const T delta = x - mean_;
+        mean_ += delta / static_cast<T>(count_);
+        m2_ += delta * (x - mean_);
+    }
+
+    constexpr void merge(const mean_variance& other) noexcept {
+        if (other.count_ == 0)
+            return;
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+        const std::uint64_t count = count_ + other.count_;
+        const T             delta = other.mean_ - mean_;
+        const T             n     = static_cast<T>(count);
+        mean_ += delta * static_cast<T>(other.count_) / n;
+        m2_ += other.m2_ + delta * delta * static_cast<T>(count_) * static_cast<T>(other.count_) / n;
+        count_ = count;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t count() const noexcept { return count_; }
+    [[nodiscard]] constexpr T             mean() const noexcept { return mean_; }
+    // The population variance; zero for fewer than one element.
+    [[nodiscard]] constexpr T variance() const noexcept { return count_ < 1 ? T(0) : m2_ / static_cast<T>(count_); }
+    // The sample variance; zero for fewer than two elements.
+    [[nodiscard]] constexpr T sample_variance() const noexcept {
+        return count_ < 2 ? T(0) : m2_ / static_cast<T>(count_ - 1);
+    }
+
+    friend constexpr bool operator==(const mean_variance&, const mean_variance&) = default;
+};
+
+// The minimum and maximum with their zero-based positions; the first occurrence wins ties. `min()` and `max()` are
+// meaningful only once `count()` is non-zero.
+template <std::totally_ordered T>
+    requires std::copyable<T> && std::default_initializable<T>
+class extrema {
+    T             min_{};
+    T             max_{};
+    std::uint64_t argmin_ = 0;
+    std::uint64_t argmax_ = 0;
+    std::uint64_t count_  = 0;
+
+  public:
+    constexpr void update(const T& x) {
+        const std::uint64_t index = count_++;
+        if (index == 0 || x < min_) {
+            min_    = x;
+            argmin_ = index;
+        }
+        if (index == 0 || max_ < x) {
+            max_    = x;
+            argmax_ = index;
+        }
+    }
+
+    // Merges the state of the elements that follow those of `*this`.
+    constexpr void merge(const extrema& other) {
+        if (other.count_ == 0)
+            return;
+        if (count_ == 0) {
+            *this = other;
+            return;
+        }
+        if (other.min_ < min_) {
+            min_    = other.min_;
+            argmin_ = count_ + other.argmin_;
+        }
+        if (max_ < other.max_) {
+            max_    = other.max_;
+            argmax_ = count_ + other.argmax_;
+        }
+        count_ += other.count_;
+    }
+
+    [[nodiscard]] constexpr const T&      min() const noexcept { return min_; }
+    [[nodiscard]] constexpr const T&      max() const noexcept { return max_; }
+    [[nodiscard]] constexpr std::uint64_t argmin() const noexcept { return argmin_; }
+    [[nodiscard]] constexpr std::uint64_t argmax() const noexcept { return argmax_; }
+    [[nodiscard]] constexpr std::uint64_t count() const noexcept { return count_; }
+
+    friend constexpr bool operator==(const extrema&, const extrema&) = default;
+};
+
+namespace detail {
+
+// The splitmix64 finalizer; `std::hash` of integers is often the identity, which would leave the high bits empty.
+constexpr std::uint64_t mix64(std::uint64_t h) noexcept { // exposition only
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+} // namespace detail
+
+// A HyperLogLog sketch of the number of distinct elements with 2^P one-byte registers; its relative standard error is
+// about 1.04 / 2^(P/2), e.g. 1.6% for the default P = 12 (4 KiB). Elements are hashed with `std::hash`.
+template <unsigned P = 12>
+    requires(P >= 4 && P <= 18)
+class hyperloglog {
+    static constexpr std::size_t m = std::size_t{1} << P;
+
+    std::array<std::uint8_t, m> registers_{};
+
+  public:
+    template <class X>
+        requires requires(const X& x) {
+            { std::hash<std::remove_cvref_t<X> >{}(x) } -> std::convertible_to<std::size_t>;
+        }
+    constexpr void update(const X& x) noexcept {
+        const std::uint64_t h    = detail::mix64(std::hash<std::remove_cvref_t<X> >{}(x));
+        const std::size_t   i    = static_cast<std::size_t>(h >> (64 - P));
+        // The position of the first set bit among the remaining 64 - P bits, capped by a sentinel bit.
+        const auto rank = static_cast<std::uint8_t>(std::countl_zero((h << P) | (std::uint64_t{1} << (P - 1))) + 1);
+        registers_[i]   = std::max(registers_[i], rank);
+    }
+
+    constexpr void merge(const hyperloglog& other) noexcept {
+        for (std::size_t i = 0; i < m; ++i)
+            registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+
+    // The estimated number of distinct elements, with linear counting for small cardinalities.
+    [[nodiscard]] double estimate() const noexcept {
+        double      sum   = 0;
+        std::size_t zeros = 0;
+        for (std::uint8_t r : registers_) {
+            sum += std::ldexp(1.0, -static_cast<int>(r));
+            zeros += r == 0;
+        }
+        const double md    = static_cast<double>(m);
+        const double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1 + 1.079 / md);
+        const double raw   = alpha * md * md / sum;
+        if (raw <= 2.5 * md && zeros != 0)
+            return md * std::log(md / static_cast<double>(zeros));
+        return raw;
+    }
+
+    friend constexpr bool operator==(const hyperloglog&, const hyperloglog&) = default;
+};
+
+// A quantile sketch with relative error guarantees (DDSketch): every returned quantile is within a factor of
+// `1 ± relative_accuracy` of an element of the right rank. Values are counted in logarithmically spaced buckets; once
+// either sign uses more than `max_buckets` buckets, the buckets of the smallest magnitudes are collapsed. Sketches can
+// only be merged with sketches of the same accuracy. Infinities are counted exactly and are their own quantiles; NaNs
+// are ignored and do not count.
+class quantile_sketch {
+    struct store {
+        std::int32_t               offset = 0;
+        std::vector<std::uint64_t> counts; // counts[i] is the count of the bucket with index offset + i
+
+        void add(std::int32_t index, std::uint64_t n, std::size_t max_buckets) {
+            if (counts.empty()) {
+                offset = index;
+                counts.assign(1, n);
+                return;
+            }
+            const std::int32_t last = offset + static_cast<std::int32_t>(counts.size()) - 1;
+            const std::int32_t hi   = std::max(index, last);
+            const std::int32_t lo =
+                std::max(std::min(index, offset), hi - static_cast<std::int32_t>(max_buckets) + 1);
+            if (lo != offset || hi != last) {
+                std::vector<std::uint64_t> resized(static_cast<std::size_t>(hi - lo) + 1);
+                for (std::size_t i = 0; i < counts.size(); ++i)
+                    resized[static_cast<std::size_t>(std::max(offset + static_cast<std::int32_t>(i), lo) - lo)] +=
+                        counts[i];
+                counts = std::move(resized);
+                offset = lo;
+            }
+            counts[static_cast<std::size_t>(std::max(index, lo) - lo)] += n;
+        }
+
+        void merge(const store& other, std::size_t max_buckets) {
+            for (std::size_t i = 0; i < other.counts.size(); ++i)
+                if (other.counts[i] != 0)
+                    add(other.offset + static_cast<std::int32_t>(i), other.counts[i], max_buckets);
+        }
+
+        friend bool operator==(const store&, const store&) = default;
+    };
+
+    double        accuracy_;
+    double        gamma_;
+    double        log_gamma_;
+    std::size_t   max_buckets_;
+    store         positive_;
+    store         negative_;
+    std::uint64_t zeros_              = 0;
+    std::uint64_t negative_infinities_ = 0;
+    std::uint64_t positive_infinities_ = 0;
+    std::uint64_t count_              = 0;
+
+    // The bucket of a finite, positive `magnitude`. The clamp only matters for extreme accuracies, whose indices would
+    // not fit.
+    std::int32_t index(double magnitude) const noexcept {
+        constexpr double limit = 1 << 30;
+        return static_cast<std::int32_t>(std::clamp(std::ceil(std::log(magnitude) / log_gamma_), -limit, limit));
+    }
+    double value(std::int32_t index) const noexcept { return 2 * std::exp(index * log_gamma_) / (gamma_ + 1); }
+
+  public:
+    explicit quantile_sketch(double relative_accuracy = 0.01, std::size_t max_buckets = 2048)
+        : accuracy_{relative_accuracy},
+          gamma_{(1 + relative_accuracy) / (1 - relative_accuracy)},
+          log_gamma_{std::log(gamma_)},
+          max_buckets_{max_buckets} {}
+
+    void update(double x) {
+        if (std::isnan(x))
+            return;
+        ++count_;
+        if (std::isinf(x))
+            ++(x > 0 ? positive_infinities_ : negative_infinities_);
+        else if (x >= std::numeric_limits<double>::min())
+            positive_.add(index(x), 1, max_buckets_);
+        else if (x <= -std::numeric_limits<double>::min())
+            negative_.add(index(-x), 1, max_buckets_);
+        else
+            ++zeros_;
+    }
+
+    void merge(const quantile_sketch& other) {
+        positive_.merge(other.positive_, max_buckets_);
+        negative_.merge(other.negative_, max_buckets_);
+        zeros_ += other.zeros_;
+        negative_infinities_ += other.negative_infinities_;
+        positive_infinities_ += other.positive_infinities_;
+        count_ += other.count_;
+    }
+
+    // The estimated `q`-quantile for `q` in [0, 1], or NaN if the sketch is empty.
+    [[nodiscard]] double quantile(double q) const noexcept {
+        if (count_ == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+        const double  rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(count_ - 1);
+        std::uint64_t seen = negative_infinities_;
+        if (static_cast<double>(seen) > rank)
+            return -std::numeric_limits<double>::infinity();
+        for (std::size_t i = negative_.counts.size(); i-- > 0;) {
+            seen += negative_.counts[i];
+            if (static_cast<double>(seen) > rank)
+                return -value(negative_.offset + static_cast<std::int32_t>(i));
+        }
+        seen += zeros_;
+        if (static_cast<double>(seen) > rank)
+            return 0;
+        for (std::size_t i = 0; i < positive_.counts.size(); ++i) {
+            seen += positive_.counts[i];
+            if (static_cast<double>(seen) > rank)
+                return value(positive_.offset + static_cast<std::int32_t>(i));
+        }
+        if (positive_infinities_ != 0)
+            return std::numeric_limits<double>::infinity();
+        return value(positive_.offset + static_cast<std::int32_t>(positive_.counts.size()) - 1);
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+    [[nodiscard]] double        relative_accuracy() const noexcept { return accuracy_; }
+
+    friend bool operator==(const quantile_sketch&, const quantile_sketch&) = default;
+};
+
+namespace detail {
+
+struct stat_update_fn {
+    template <class S, class X>
+        requires requires(S& state, X&& x) { state.update(std::forward<X>(x)); }
+    constexpr S operator()(S state, X&& x) const {
+        state.update(std::forward<X>(x));
+        return state;
+    }
+
+    template <class S, class X>
+        requires requires(S& state, X&& x) { state.update(std::forward<X>(x)); }
+    constexpr void accumulate(S& state, X&& x) const {
+        state.update(std::forward<X>(x));
+    }
+};
+
+struct stat_merge_fn {
+    template <class S>
+        requires requires(S& state, const S& other) { state.merge(other); }
+    constexpr S operator()(S state, const S& other) const {
+        state.merge(other);
+        return state;
+    }
+
+    template <class S>
+        requires requires(S& state, const S& other) { state.merge(other); }
+    constexpr void accumulate(S& state, const S& other) const {
+        state.merge(other);
+    }
+};
+
+} // namespace detail
+
+template <>
+inline constexpr bool enable_accumulate_in_place<detail::stat_update_fn> = true;
+template <>
+inline constexpr bool enable_accumulate_in_place<detail::stat_merge_fn> = true;
+
+namespace detail {
+
+struct running_stat_t {
+    constexpr running_stat_t() = default;
+    template <std::ranges::input_range R, class S>
+    constexpr auto operator()(R&& r, S&& state) const {
+        return scan(std::forward<R>(r), stat_update_fn{}, std::forward<S>(state));
+    }
+
+    template <class S>
+    constexpr auto operator()(S&& state) const {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this, std::forward<S>(state)));
+    }
+};
+
+} // namespace detail
+
+// `stat_update(state, x)` returns `state` updated with `x`; scans use its in-place form.
+inline constexpr detail::stat_update_fn stat_update{};
+// `stat_merge(a, b)` returns `a` merged with `b`, for combining states of consecutive parts of the input.
+inline constexpr detail::stat_merge_fn stat_merge{};
+// `r | running_stat(state)` produces the running statistic after each element, starting from `state`.
+inline constexpr detail::running_stat_t running_stat{};
+
+} // namespace beman::scan_view
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_RUNNING_STATS_HPP
@@ -28,6 +28,60 @@ namespace beman::scan_view {
 
 enum class scan_view_kind : bool { unseeded, seeded };
 
+// Specialize as `true` for a scan operator type `F` whose member `accumulate(acc, x)` has the effect of
+// `acc = f(std::move(acc), x)`. Scans then update the accumulator in place instead of moving it through `f` on every
+// step, which matters for large states. A member of that name alone is not enough: it may mean something else.
+template <class F>
+inline constexpr bool enable_accumulate_in_place = false;
+
+namespace detail {
+
+template <class F, class U, class R>
+concept accumulates_in_place = // exposition only
+    enable_accumulate_in_place<std::remove_cv_t<F> > &&
+    requires(F& f, U& acc, R&& x) { f.accumulate(acc, std::forward<R>(x)); };
+
+// The iterators of `scan_view`, identified to `checkpoint` by a member tag. A base class would also mark them, but
+// would keep the empty base optimization from applying to a scan of a scan.
+template <class I>
+concept scan_view_iterator = // exposition only
+    std::same_as<typename I::scan_view_iterator_tag, std::remove_cvref_t<I> >;
+
+// What a scan iterator over `maybe_const<Const, V>` keeps of its parent view. The end sentinel is stored next to the
+// current position, so that `operator++` and the comparison with `default_sentinel` never load through a pointer to
+// the parent view. A tidy functor is stored by value (and occupies no space); otherwise only the functor is
+// referenced.
+template <class V, class F, bool Const>
+class scan_iterator_holder { // exposition only
+    using Base       = maybe_const<Const, V>;                                   // exposition only
+    using Func       = maybe_const<Const, F>;                                   // exposition only
+    using FunStorage = std::conditional_t<tidy_func<F>, movable_box<F>, Func*>; // exposition only
+
+    std::ranges::sentinel_t<Base>    end_ = std::ranges::sentinel_t<Base>(); // exposition only
+    [[no_unique_address]] FunStorage fun_ = FunStorage();                   // exposition only
+
+    friend class scan_iterator_holder<V, F, !Const>;
+
+  public:
+    scan_iterator_holder() = default;
+    constexpr scan_iterator_holder(std::ranges::sentinel_t<Base> end, [[maybe_unused]] Func& fun)
+        : end_{std::move(end)} {
+        if constexpr (!tidy_func<F>)
+            fun_ = std::addressof(fun);
+    }
+    constexpr scan_iterator_holder(scan_iterator_holder<V, F, !Const> other)
+        requires Const && std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<Base> >
+        : end_{std::move(other.end_)} {
+        if constexpr (!tidy_func<F>)
+            fun_ = other.fun_;
+    }
+
+    constexpr const std::ranges::sentinel_t<Base>& end() const noexcept { return end_; }
+    constexpr Func&                                fun() noexcept { return *fun_; }
+};
+
+} // namespace detail
+
 template <typename V, typename F, typename T, scan_view_kind K>
 concept scannable = // exposition only
     std::move_constructible<F> && std::invocable<F&, T, std::ranges::range_reference_t<V> > &&
@@ -129,55 +183,40 @@ class scan_view<V, F, T, K>::iterator {
     using ResultType = std::decay_t<                          // exposition only
         std::invoke_result_t<Func&, T, std::ranges::range_reference_t<Base> > >;
 
-    struct Holder {                                                           // exposition only
-        std::ranges::sentinel_t<Base> end_ = std::ranges::sentinel_t<Base>(); // exposition only
-        detail::movable_box<F>        fun_;                                   // exposition only
-    };
-    using HolderType = std::conditional_t<detail::tidy_func<F>, Holder, Parent*>; // exposition only
-
-    std::ranges::iterator_t<Base>   current_ = std::ranges::iterator_t<Base>(); // exposition only
-    HolderType                      parent_  = {};                              // exposition only
-    detail::movable_box<ResultType> sum_;                                       // exposition only
-
-    constexpr std::ranges::sentinel_t<Base> get_end() const { // exposition only
-        if constexpr (detail::tidy_func<F>)
-            return parent_.end_;
-        else
-            return std::ranges::end(parent_->base_);
-    }
-    constexpr Func& get_fun() { // exposition only
-        if constexpr (detail::tidy_func<F>)
-            return *parent_.fun_;
+    std::ranges::iterator_t<Base>             current_ = std::ranges::iterator_t<Base>(); // exposition only
+    detail::scan_iterator_holder<V, F, Const> parent_  = {};                              // exposition only
+    detail::movable_box<ResultType>           sum_;                                       // exposition only
+
+    // The first value is constructed in place rather than assigned to a default-constructed accumulator, so an
+    // allocator-aware accumulator keeps the allocator of the initial value.
+    constexpr detail::movable_box<ResultType> first_sum(Parent& parent) { // exposition only
+        if (current_ == parent_.end())
+            return detail::movable_box<ResultType>{};
+        if constexpr (K == scan_view_kind::seeded)
+            return detail::movable_box<ResultType>{
+                std::in_place, std::invoke(parent_.fun(), detail::seed_copy(*parent.init_), *current_)};
         else
-            return *parent_->fun_;
-    }
-    static constexpr HolderType init(Parent& parent) { // exposition only
-        if constexpr (detail::tidy_func<F>)
-            return {std::ranges::end(parent.base_), detail::movable_box<F>{std::in_place}};
-        else
-            return std::addressof(parent);
+            return detail::movable_box<ResultType>{std::in_place, *current_};
     }
 
+    friend class iterator<!Const>;
+
   public:
-    using iterator_concept = std::input_iterator_tag;
-    using value_type       = ResultType;
-    using difference_type  = std::ranges::range_difference_t<Base>;
+    using iterator_concept       = std::input_iterator_tag;
+    using value_type             = ResultType;
+    using difference_type        = std::ranges::range_difference_t<Base>;
+    using scan_view_iterator_tag = iterator; // exposition only
 
     iterator()
         requires std::default_initializable<std::ranges::iterator_t<Base> >
     = default;
     constexpr iterator(Parent& parent, std::ranges::iterator_t<Base> current)
-        : current_{std::move(current)}, parent_{init(parent)} {
-        if (current_ == get_end())
-            return;
-        if constexpr (K == scan_view_kind::seeded) {
-            sum_ = detail::movable_box<ResultType>{std::in_place, std::invoke(get_fun(), *parent.init_, *current_)};
-        } else {
-            sum_ = detail::movable_box<ResultType>{std::in_place, *current_};
-        }
-    }
+        : current_{std::move(current)},
+          parent_{std::ranges::end(parent.base_), *parent.fun_},
+          sum_{first_sum(parent)} {}
     constexpr iterator(iterator<!Const> i)
-        requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base> >
+        requires Const && std::convertible_to<std::ranges::iterator_t<V>, std::ranges::iterator_t<Base> > &&
+                 std::convertible_to<std::ranges::sentinel_t<V>, std::ranges::sentinel_t<Base> >
         : current_{std::move(i.current_)}, parent_{std::move(i.parent_)}, sum_{std::move(i.sum_)} {}
 
     constexpr const std::ranges::iterator_t<Base>& base() const& noexcept { return current_; }
@@ -186,8 +225,12 @@ class scan_view<V, F, T, K>::iterator {
     constexpr const value_type& operator*() const { return *sum_; }
 
     constexpr iterator& operator++() {
-        if (++current_ != get_end()) {
-            sum_ = detail::movable_box<ResultType>{std::in_place, std::invoke(get_fun(), std::move(*sum_), *current_)};
+        if (++current_ != parent_.end()) {
+            if constexpr (detail::accumulates_in_place<Func, ResultType, std::ranges::range_reference_t<Base> >)
+                parent_.fun().accumulate(*sum_, *current_);
+            else
+                sum_ = detail::movable_box<ResultType>{std::in_place,
+                                                       std::invoke(parent_.fun(), std::move(*sum_), *current_)};
         }
         return *this;
     }
@@ -198,7 +241,9 @@ class scan_view<V, F, T, K>::iterator {
     {
         return x.current_ == y.current_;
     }
-    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) { return x.current_ == x.get_end(); }
+    friend constexpr bool operator==(const iterator& x, std::default_sentinel_t) {
+        return x.current_ == x.parent_.end();
+    }
 };
 
 namespace detail {
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_SCAN_VIEW_SCAN_STATE_HPP
+#define BEMAN_SCAN_VIEW_SCAN_STATE_HPP
+
+#include <beman/scan_view/config.hpp>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES() && !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.scan_view;
+
+#else
+
+    #if !BEMAN_SCAN_VIEW_USE_MODULES()
+
+        #include <algorithm>
+        #include <array>
+        #include <bit>
+        #include <cstddef>
+        #include <cstdint>
+        #include <iterator>
+        #include <optional>
+        #include <ranges>
+        #include <span>
+        #include <type_traits>
+        #include <utility>
+        #include <vector>
+
+    #endif // !BEMAN_SCAN_VIEW_USE_MODULES()
+
+    #include "detail/expo_only.hpp"
+    #include "scan.hpp"
+
+namespace beman::scan_view {
+
+// The state of a scan after `count` elements: `value` is the fold of those elements. Resuming a seeded scan with
+// `value` as the initial value over the remaining elements produces the same values as the original scan, so a
+// restarted stream does not need to re-scan its history.
+template <class T>
+struct scan_state {
+    T             value;
+    std::uint64_t count = 0;
+
+    friend constexpr bool operator==(const scan_state&, const scan_state&) = default;
+};
+
+// Captures the state of a scan at the element `it` refers to, which is the `count`-th element of the scan. The
+// iterator of a scan does not track its position, so the caller supplies it, e.g. the number of elements consumed
+// from a stream so far.
+template <detail::scan_view_iterator I>
+constexpr scan_state<std::iter_value_t<I> > checkpoint(const I& it, std::uint64_t count) {
+    return {*it, count};
+}
+
+// Captures the state of a scan at the element `it` refers to, computing its position from `first`, the beginning of
+// the underlying range, in constant time.
+template <detail::scan_view_iterator I, class BaseI>
+    requires std::sized_sentinel_for<BaseI, std::remove_cvref_t<decltype(std::declval<const I&>().base())> >
+constexpr scan_state<std::iter_value_t<I> > checkpoint(const I& it, const BaseI& first) {
+    return {*it, static_cast<std::uint64_t>(it.base() - first) + 1};
+}
+
+namespace detail {
+
+struct resume_scan_t {
+    constexpr resume_scan_t() = default;
+    template <std::ranges::input_range R, class F, class T>
+    constexpr auto operator()(R&& rest, F&& f, scan_state<T> state) const {
+        return scan(std::forward<R>(rest), std::forward<F>(f), std::move(state.value));
+    }
+
+    template <class F, class T>
+    constexpr auto operator()(F&& f, scan_state<T> state) const {
+        return detail::range_adaptor_closure_t(detail::bind_back(*this, std::forward<F>(f), std::move(state)));
+    }
+};
+
+} // namespace detail
+
+// `rest | resume_scan(f, state)` continues a scan with `f` from `state` over the elements after the first
+// `state.count` ones, e.g. `r | std::views::drop(state.count)` when the history is still available.
+inline constexpr detail::resume_scan_t resume_scan{};
+
+// Encodes accumulator values for `serialize_scan_state`/`deserialize_scan_state`. The primary template copies the
+// object representation of trivially copyable types; specialize it for other accumulator types, providing
+// `static void encode(const T&, std::vector<std::byte>&)`, which appends the encoding, and
+// `static std::optional<T> decode(std::span<const std::byte>)`, which returns `std::nullopt` for malformed input.
+template <class T>
+struct state_codec {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "specialize beman::scan_view::state_codec for accumulator types that are not trivially copyable");
+
+    static void encode(const T& value, std::vector<std::byte>& out) {
+        const auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)> >(value);
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+    static std::optional<T> decode(std::span<const std::byte> in) {
+        if (in.size() != sizeof(T))
+            return std::nullopt;
+        std::array<std::byte, sizeof(T)> bytes;
+        std::ranges::copy(in, bytes.begin());
+        return std::bit_cast<T>(bytes);
+    }
+};
+
+// Serializes `state` as its element count (8 bytes, native byte order) followed by the `state_codec` encoding of its
+// value.
+template <class T>
+std::vector<std::byte> serialize_scan_state(const scan_state<T>& state) {
+    std::vector<std::byte> out;
+    state_codec<std::uint64_t>::encode(state.count, out);
+    state_codec<T>::encode(state.value, out);
+    return out;
+}
+
+// Restores a state written by `serialize_scan_state`, or returns `std::nullopt` if `in` is not a valid encoding.
+template <class T>
+std::optional<scan_state<T> > deserialize_scan_state(std::span<const std::byte> in) {
+    if (in.size() < sizeof(std::uint64_t))
+        return std::nullopt;
+    auto count = state_codec<std::uint64_t>::decode(in.first(sizeof(std::uint64_t)));
+    auto value = state_codec<T>::decode(in.subspan(sizeof(std::uint64_t)));
+    if (!count || !value)
+        return std::nullopt;
+    return scan_state<T>{std::move(*value), *count};
+}
+
+} // namespace beman::scan_view
+
+#endif // #if BEMAN_SCAN_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_SCAN_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_SCAN_VIEW_SCAN_STATE_HPP
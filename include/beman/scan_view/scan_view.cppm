@@ -11,5 +11,13 @@ export {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winclude-angled-in-module-purview"
 #include <beman/scan_view/scan.hpp>
+#include <beman/scan_view/exclusive_scan.hpp>
+#include <beman/scan_view/keyed_scan.hpp>
+#include <beman/scan_view/delta_decode.hpp>
+#include <beman/scan_view/linear_recurrence.hpp>
+#include <beman/scan_view/mdscan.hpp>
+#include <beman/scan_view/pmr.hpp>
+#include <beman/scan_view/running_stats.hpp>
+#include <beman/scan_view/scan_state.hpp>
 #pragma clang diagnostic pop
 }
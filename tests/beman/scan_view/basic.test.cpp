@@ -13,6 +13,9 @@ import std;
     #include <algorithm>
     #include <array>
     #include <functional>
+    #include <numeric>
+    #include <type_traits>
+    #include <utility>
     #include <vector>
 
 #endif
@@ -190,3 +193,37 @@ TEST(ScanView, MoveOnly) {
     ASSERT_TRUE(std::ranges::equal(out4, check));
 }
 #endif
+
+TEST(ScanView, IteratorLayout) {
+    // The iterator keeps the end sentinel locally and stores the accumulator without an engaged flag, so a scan over
+    // a contiguous range of `int` is as small and as cheap to copy as a hand-written prefix-sum loop.
+    std::vector<int> vec(1000);
+    std::iota(vec.begin(), vec.end(), -500);
+
+    auto transformed = exe::scan(vec, std::plus{});
+    using It         = decltype(transformed.begin());
+    static_assert(std::is_trivially_copyable_v<It>);
+    static_assert(sizeof(It) <= 2 * sizeof(int*) + sizeof(int) + alignof(int*));
+
+    auto transformed2 = exe::scan(vec, NonTrivialFunctor{});
+    using It2         = decltype(transformed2.begin());
+    static_assert(std::is_trivially_copyable_v<It2>);
+    static_assert(sizeof(It2) <= 3 * sizeof(int*) + sizeof(int) + alignof(int*));
+
+    // A scan of a scan only adds its own accumulator: the empty sentinel and functor take no space.
+    auto nested = exe::scan(transformed, std::plus{});
+    using It3   = decltype(nested.begin());
+    static_assert(sizeof(It3) <= sizeof(It) + sizeof(int) + alignof(int*));
+
+    std::vector<int> expected(vec.size());
+    int              sum = 0;
+    for (std::size_t i = 0; i < vec.size(); ++i)
+        expected[i] = sum += vec[i];
+    ASSERT_TRUE(std::ranges::equal(transformed, expected));
+    ASSERT_TRUE(std::ranges::equal(transformed2, expected));
+
+    decltype(std::as_const(transformed2).begin()) cit = transformed2.begin();
+    ASSERT_EQ(*cit, -500);
+    ++cit;
+    ASSERT_EQ(*cit, -999);
+}
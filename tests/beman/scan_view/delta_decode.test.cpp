@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <cstdint>
+    #include <limits>
+    #include <vector>
+
+#endif
+
+#include <beman/scan_view/delta_decode.hpp>
+
+namespace exe = beman::scan_view;
+
+namespace {
+
+std::vector<std::uint8_t> encodeVarintDeltas(const std::vector<std::int64_t>& values, std::int64_t base) {
+    std::vector<std::uint8_t> out;
+    for (auto v : values) {
+        const auto delta = v - base;
+        base             = v;
+        auto u = (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63); // zigzag
+        do {
+            std::uint8_t byte = u & 0x7f;
+            u >>= 7;
+            if (u != 0)
+                byte |= 0x80;
+            out.push_back(byte);
+        } while (u != 0);
+    }
+    return out;
+}
+
+// Packs `fields` into exactly as many words as they need, plus `spare` unused words.
+template <class W>
+std::vector<W> pack(const std::vector<std::uint64_t>& fields, unsigned bit_width, std::size_t spare = 0) {
+    constexpr unsigned digits = std::numeric_limits<W>::digits;
+    std::vector<W>     out((fields.size() * bit_width + digits - 1) / digits + spare);
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        for (unsigned b = 0; b < bit_width; ++b) {
+            if ((fields[i] >> b) & 1u) {
+                const std::size_t bit = i * bit_width + b;
+                out[bit / digits] |= static_cast<W>(W(1) << (bit % digits));
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(DeltaDecode, Varint) {
+    std::vector<std::int64_t> values  = {1000, 1001, 1001, 999, 5000000000, -7, 0};
+    auto                      encoded = encodeVarintDeltas(values, 100);
+    auto                      decoded = exe::delta_decode_varint(encoded, std::int64_t{100});
+    ASSERT_TRUE(std::ranges::equal(decoded, values));
+    ASSERT_TRUE(std::ranges::equal(encoded | exe::delta_decode_varint(std::int64_t{100}), values));
+
+    std::vector<std::uint8_t> plain   = {1, 2, 0x80, 0x01, 3};
+    std::uint32_t             check[] = {11, 13, 141, 144};
+    ASSERT_TRUE(std::ranges::equal(exe::delta_decode_varint(plain, std::uint32_t{10}), check));
+
+    std::vector<std::uint8_t> empty;
+    auto                      none = exe::delta_decode_varint(empty, 0);
+    ASSERT_TRUE(none.begin() == none.end());
+
+    // A truncated last varint ends the view.
+    std::vector<std::uint8_t> truncated  = {0x01, 0x85};
+    std::uint32_t             first[]    = {1};
+    ASSERT_TRUE(std::ranges::equal(exe::delta_decode_varint(truncated, 0u), first));
+    std::vector<std::uint8_t> only      = {0x80};
+    auto                      unfinished = exe::delta_decode_varint(only, 0u);
+    ASSERT_TRUE(unfinished.begin() == unfinished.end());
+}
+
+TEST(DeltaDecode, Bitpacked) {
+    for (std::size_t count : {100u, 1000u}) {
+        for (unsigned width : {0u, 1u, 3u, 7u, 13u, 31u, 32u}) {
+            std::vector<std::uint64_t> fields;
+            for (std::uint64_t i = 0; i < count; ++i)
+                fields.push_back(width == 0 ? 0 : (i * 2654435761u) & ((std::uint64_t{1} << width) - 1));
+            const std::int64_t        base      = -50;
+            const std::int64_t        min_delta = -3;
+            std::vector<std::int64_t> expected;
+            std::int64_t              sum = base;
+            for (auto f : fields)
+                expected.push_back(sum += min_delta + static_cast<std::int64_t>(f));
+
+            // Without a spare word, the fields at the end of the block lie in the last word.
+            for (std::size_t spare : {0u, 1u}) {
+                auto words32 = pack<std::uint32_t>(fields, width, spare);
+                auto lazy    = exe::delta_decode_bitpacked(words32, width, fields.size(), base, min_delta);
+                ASSERT_EQ(lazy.size(), fields.size());
+                ASSERT_TRUE(std::ranges::equal(lazy, expected)) << "width " << width << " spare " << spare;
+
+                if (width <= 8) {
+                    auto words8 = pack<std::uint8_t>(fields, width, spare);
+                    auto piped  = words8 | exe::delta_decode_bitpacked(width, fields.size(), base, min_delta);
+                    ASSERT_TRUE(std::ranges::equal(piped, expected)) << "width " << width << " spare " << spare;
+                }
+
+                std::vector<std::int64_t> block(fields.size());
+                auto last = exe::delta_decode_bitpacked_block(words32, width, base, block, min_delta);
+                ASSERT_EQ(block, expected) << "width " << width << " spare " << spare;
+                ASSERT_EQ(last, expected.back());
+
+                auto                      words64 = pack<std::uint64_t>(fields, width, spare);
+                std::vector<std::int64_t> block64(fields.size());
+                exe::delta_decode_bitpacked_block(words64, width, base, block64, min_delta);
+                ASSERT_EQ(block64, expected) << "width " << width << " spare " << spare;
+            }
+        }
+    }
+
+    // Full-width fields: every field is a whole word.
+    std::vector<std::uint64_t> fields(600);
+    for (std::size_t i = 0; i < fields.size(); ++i)
+        fields[i] = i * 0x9e3779b97f4a7c15u;
+    std::vector<std::uint64_t> expected;
+    std::uint64_t              sum = 1;
+    for (auto f : fields)
+        expected.push_back(sum += f);
+    auto words = pack<std::uint64_t>(fields, 64);
+    ASSERT_EQ(words, fields);
+    ASSERT_TRUE(std::ranges::equal(exe::delta_decode_bitpacked(words, 64, fields.size(), std::uint64_t{1}), expected));
+    std::vector<std::uint64_t> block(fields.size());
+    ASSERT_EQ(exe::delta_decode_bitpacked_block(words, 64, std::uint64_t{1}, block), expected.back());
+    ASSERT_EQ(block, expected);
+}
+
+TEST(DeltaDecode, ShortWords) {
+    // Fields past the end of the words read as zero in both forms.
+    std::vector<std::uint64_t> fields(300, 5);
+    auto                       words = pack<std::uint32_t>(fields, 7);
+    words.resize(words.size() / 2);
+    auto lazy = exe::delta_decode_bitpacked(words, 7, fields.size(), 0u);
+
+    std::vector<unsigned> block(fields.size());
+    exe::delta_decode_bitpacked_block(words, 7, 0u, block);
+    ASSERT_TRUE(std::ranges::equal(lazy, block));
+    ASSERT_EQ(block.back(), block[words.size() * 32 / 7]);
+
+    std::vector<std::uint32_t> none;
+    std::vector<unsigned>      zeros(10);
+    ASSERT_EQ(exe::delta_decode_bitpacked_block(none, 7, 3u, zeros), 3u);
+    ASSERT_TRUE(std::ranges::all_of(zeros, [](unsigned v) { return v == 3; }));
+}
+
+TEST(DeltaDecode, Overlong) {
+    // The bits of a varint beyond the width of the value type are discarded.
+    std::vector<std::uint8_t> bytes = {0x81, 0x80, 0x80, 0x80, 0x70};
+    std::uint32_t             low[] = {1};
+    ASSERT_TRUE(std::ranges::equal(exe::delta_decode_varint(bytes, 0u), low));
+}
+
+TEST(DeltaDecode, BlockChaining) {
+    // Decoding a column block by block, each block continues from the last value of the previous one.
+    std::vector<std::uint64_t> fields(256);
+    for (std::size_t i = 0; i < fields.size(); ++i)
+        fields[i] = i % 17;
+    auto words = pack<std::uint64_t>(fields, 5);
+
+    std::vector<std::uint32_t> whole(fields.size());
+    exe::delta_decode_bitpacked_block(words, 5, 7u, whole);
+
+    std::vector<std::uint32_t> blocks(fields.size());
+    const std::size_t          block_size = 64; // multiple of 64 bits, so every block starts on a word boundary
+    std::uint32_t              base       = 7;
+    for (std::size_t b = 0; b < fields.size(); b += block_size) {
+        auto in  = std::ranges::subrange(words.begin() + static_cast<std::ptrdiff_t>(b * 5 / 64), words.end());
+        auto out = std::ranges::subrange(blocks.begin() + static_cast<std::ptrdiff_t>(b),
+                                         blocks.begin() + static_cast<std::ptrdiff_t>(b + block_size));
+        base     = exe::delta_decode_bitpacked_block(in, 5, base, out);
+    }
+    ASSERT_EQ(blocks, whole);
+}
+
+TEST(DeltaDecode, Properties) {
+    std::vector<std::uint32_t> words = {0};
+    auto                       view  = exe::delta_decode_bitpacked(words, 4, 8, 0u);
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(view)>, unsigned>);
+    static_assert(std::ranges::sized_range<decltype(view)>);
+    static_assert(std::ranges::borrowed_range<decltype(view)>);
+
+    std::vector<std::uint8_t> bytes;
+    auto                      view2 = exe::delta_decode_varint(bytes, 0);
+    static_assert(std::ranges::input_range<decltype(view2)> && !std::ranges::sized_range<decltype(view2)>);
+    static_assert(std::ranges::borrowed_range<decltype(view2)>);
+}
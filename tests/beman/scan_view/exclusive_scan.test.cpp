@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <array>
+    #include <functional>
+    #include <string>
+    #include <vector>
+
+#endif
+
+#include <beman/scan_view/exclusive_scan.hpp>
+
+namespace exe = beman::scan_view;
+
+struct NonTrivialFunctor {
+    int           var_;
+    constexpr int operator()(int a, int b) const { return a + b; }
+};
+
+TEST(ExclusiveScanView, General) {
+    std::vector<int> vec         = {1, 2, 3, 4};
+    auto             transformed = exe::exclusive_scan(vec, std::plus{}, 0);
+    int              expected[]  = {0, 1, 3, 6};
+    ASSERT_TRUE(std::ranges::equal(transformed, expected));
+    const auto& ct = transformed;
+    ASSERT_TRUE(std::ranges::equal(ct, expected));
+
+    auto transformed2 = vec | exe::exclusive_scan_with_total(std::plus{}, 10);
+    int  expected2[]  = {10, 11, 13, 16, 20};
+    ASSERT_TRUE(std::ranges::equal(transformed2, expected2));
+
+    std::vector<std::string> words       = {"a", "b", "c"};
+    auto                     cat         = exe::exclusive_scan(words, std::plus{}, std::string{">"});
+    std::string              expected3[] = {">", ">a", ">ab"};
+    ASSERT_TRUE(std::ranges::equal(cat, expected3));
+}
+
+TEST(ExclusiveScanView, Empty) {
+    std::vector<int> vec;
+    ASSERT_TRUE(std::ranges::empty(exe::exclusive_scan(vec, std::plus{}, 7)));
+    auto with_total = exe::exclusive_scan_with_total(vec, std::plus{}, 7);
+    ASSERT_EQ(with_total.size(), 1);
+    int expected[] = {7};
+    ASSERT_TRUE(std::ranges::equal(with_total, expected));
+}
+
+TEST(ExclusiveScanView, Constexpr) {
+    static constexpr std::array<int, 4> arr         = {1, 2, 3, 4};
+    static constexpr auto               transformed = exe::exclusive_scan(arr, std::plus{}, 0);
+    static constexpr std::array<int, 4> expected    = {0, 1, 3, 6};
+    static_assert(std::ranges::equal(transformed, expected));
+
+    static constexpr auto               transformed2 = exe::exclusive_scan_with_total(arr, std::plus{}, 0);
+    static constexpr std::array<int, 5> expected2    = {0, 1, 3, 6, 10};
+    static_assert(std::ranges::equal(transformed2, expected2));
+}
+
+TEST(ExclusiveScanView, Properties) {
+    std::vector<int> vec         = {1, 2, 3, 4};
+    auto             transformed = exe::exclusive_scan(vec, std::plus{}, 0);
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(transformed)>, int>);
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(transformed)>, const int&>);
+    static_assert(std::ranges::input_range<decltype(transformed)> &&
+                  !std::ranges::forward_range<decltype(transformed)>);
+    static_assert(!std::ranges::common_range<decltype(transformed)>);
+    static_assert(std::ranges::sized_range<decltype(transformed)>);
+    static_assert(std::ranges::range<const decltype(transformed)>);
+    static_assert(std::ranges::borrowed_range<decltype(transformed)>);
+    ASSERT_EQ(transformed.size(), 4);
+
+    auto transformed2 = exe::exclusive_scan_with_total(vec, NonTrivialFunctor{}, 0);
+    static_assert(std::ranges::sized_range<decltype(transformed2)>);
+    static_assert(!std::ranges::borrowed_range<decltype(transformed2)>);
+    ASSERT_EQ(transformed2.size(), 5);
+    ASSERT_EQ(std::ranges::distance(transformed2), 5);
+}
+
+TEST(ExclusiveScanView, Borrowed) {
+    std::vector<int>                                                      vec = {1, 2, 3, 4};
+    decltype(exe::exclusive_scan_with_total(vec, std::plus{}, 0).begin()) it;
+    {
+        auto transformed = exe::exclusive_scan_with_total(vec, std::plus{}, 0);
+        it               = transformed.begin();
+    }
+    ASSERT_EQ(*it, 0);
+    ++it;
+    ASSERT_EQ(*it, 1);
+}
+
+TEST(ExclusiveScanView, FoldsOnlyObservedValues) {
+    std::vector<int> vec   = {1, 2, 3, 4};
+    int              calls = 0;
+    auto             plus  = [&calls](int a, int b) {
+        ++calls;
+        return a + b;
+    };
+
+    // The fold with the last element is only needed for the total.
+    for (int v : exe::exclusive_scan(vec, plus, 0))
+        static_cast<void>(v);
+    ASSERT_EQ(calls, 3);
+
+    calls = 0;
+    for (int v : exe::exclusive_scan_with_total(vec, plus, 0))
+        static_cast<void>(v);
+    ASSERT_EQ(calls, 4);
+}
+
+TEST(ExclusiveScanView, HistogramOffsets) {
+    std::vector<unsigned char> keys    = {3, 0, 1, 3, 3, 0};
+    std::vector<int>           offsets = {-1, -1, -1, -1, -1};
+    auto                       last    = exe::histogram_offsets(keys, offsets);
+    ASSERT_EQ(last, offsets.end());
+    int expected[] = {0, 2, 3, 3, 6};
+    ASSERT_TRUE(std::ranges::equal(offsets, expected));
+
+    // The offsets drive a stable counting-sort scatter without a second count buffer.
+    std::vector<unsigned char> sorted(keys.size());
+    for (auto key : keys)
+        sorted[static_cast<std::size_t>(offsets[key]++)] = key;
+    ASSERT_TRUE(std::ranges::is_sorted(sorted));
+
+    std::vector<int>           no_keys;
+    std::array<std::size_t, 1> total = {42};
+    exe::histogram_offsets(no_keys, total);
+    ASSERT_EQ(total[0], 0);
+}
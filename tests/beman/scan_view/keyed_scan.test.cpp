@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <cstddef>
+    #include <functional>
+    #include <map>
+    #include <ranges>
+    #include <string>
+    #include <utility>
+    #include <vector>
+
+#endif
+
+#include <beman/scan_view/keyed_scan.hpp>
+
+namespace exe = beman::scan_view;
+
+namespace {
+
+struct Trade {
+    std::string symbol;
+    int         volume;
+};
+
+// A key that counts how often it is copied.
+struct CountingKey {
+    static inline int copies = 0;
+
+    int id;
+
+    explicit CountingKey(int i) : id{i} {}
+    CountingKey(const CountingKey& other) : id{other.id} { ++copies; }
+    CountingKey(CountingKey&&) = default;
+    CountingKey& operator=(const CountingKey&) = default;
+    CountingKey& operator=(CountingKey&&) = default;
+
+    friend bool operator==(const CountingKey&, const CountingKey&) = default;
+};
+
+struct Record {
+    CountingKey key;
+    int         value;
+};
+
+} // namespace
+
+template <>
+struct std::hash<CountingKey> {
+    std::size_t operator()(const CountingKey& key) const noexcept { return std::hash<int>{}(key.id); }
+};
+
+TEST(KeyedScan, Unseeded) {
+    std::vector<int> vec  = {1, 12, 3, 14, 25, 6};
+    auto             tens = [](int x) { return x / 10; };
+    int              expected[] = {1, 12, 4, 26, 25, 10};
+    ASSERT_TRUE(std::ranges::equal(exe::keyed_scan(vec, tens, std::plus{}), expected));
+    ASSERT_TRUE(std::ranges::equal(vec | exe::keyed_scan(tens, std::plus{}), expected));
+
+    std::vector<int> empty;
+    auto             none = exe::keyed_scan(empty, tens, std::plus{});
+    ASSERT_TRUE(none.begin() == none.end());
+}
+
+TEST(KeyedScan, Seeded) {
+    std::vector<Trade> trades = {{"ABC", 10}, {"XYZ", 5}, {"ABC", 7}, {"DEF", 1}, {"XYZ", 2}};
+    auto               volume = trades | exe::keyed_scan(&Trade::symbol,
+                                           [](long acc, const Trade& t) { return acc + t.volume; },
+                                           100L);
+    long expected[] = {110, 105, 117, 101, 107};
+    ASSERT_TRUE(std::ranges::equal(volume, expected));
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(volume)>, long>);
+    ASSERT_EQ(volume.size(), trades.size());
+
+    // Every call of begin() starts over with an empty table.
+    ASSERT_TRUE(std::ranges::equal(volume, expected));
+}
+
+TEST(KeyedScan, MatchesReference) {
+    std::vector<int> vec(10000);
+    for (std::size_t i = 0; i < vec.size(); ++i)
+        vec[i] = static_cast<int>((i * 2654435761u) % 1000);
+
+    std::map<int, long> sums;
+    std::vector<long>   expected;
+    for (int x : vec)
+        expected.push_back(sums[x % 97] += x);
+
+    auto mod97 = [](int x) { return x % 97; };
+    auto add   = [](long acc, int x) { return acc + x; };
+    ASSERT_TRUE(std::ranges::equal(exe::keyed_scan(vec, mod97, add, 0L), expected));
+    ASSERT_TRUE(std::ranges::equal(
+        exe::keyed_scan_view(vec, mod97, add, 0L, exe::keyed_scan_options{.capacity_hint = 97}), expected));
+}
+
+TEST(KeyedScan, Eviction) {
+    std::vector<int> vec = {1, 2, 1, 3, 4, 5, 1, 2, 1};
+    auto             bounded =
+        exe::keyed_scan_view(vec, std::identity{}, std::plus{}, exe::keyed_scan_options{.max_keys = 2});
+
+    // With at most two tracked keys, keys drop out and restart; values are never larger than the unbounded ones.
+    std::vector<int> unbounded;
+    for (int v : exe::keyed_scan(vec, std::identity{}, std::plus{}))
+        unbounded.push_back(v);
+    std::size_t i = 0;
+    for (int v : bounded) {
+        ASSERT_LE(v, unbounded[i]);
+        ASSERT_EQ(v % vec[i], 0);
+        ++i;
+    }
+    ASSERT_EQ(i, vec.size());
+
+    // The first two distinct keys fit, so the prefix matches.
+    ASSERT_TRUE(std::ranges::equal(bounded | std::views::take(3), unbounded | std::views::take(3)));
+}
+
+TEST(KeyedScan, CopiesStartEmpty) {
+    std::vector<int> vec  = {1, 1, 1};
+    auto             view = exe::keyed_scan(vec, std::identity{}, std::plus{});
+    auto             it   = view.begin();
+    ++it;
+    ASSERT_EQ(*it, 2);
+
+    auto copy       = view;
+    int  expected[] = {1, 2, 3};
+    ASSERT_TRUE(std::ranges::equal(copy, expected));
+    ++it;
+    ASSERT_EQ(*it, 3);
+}
+
+TEST(KeyedScan, KeyCopies) {
+    std::vector<Record> records;
+    for (int i = 0; i < 100; ++i)
+        records.push_back({CountingKey{i % 3}, i});
+
+    CountingKey::copies = 0;
+    auto sums = exe::keyed_scan(records, &Record::key, [](int acc, const Record& r) { return acc + r.value; }, 0);
+    std::vector<int> expected;
+    int              totals[3] = {};
+    for (const auto& r : records)
+        expected.push_back(totals[r.key.id] += r.value);
+    ASSERT_TRUE(std::ranges::equal(sums, expected));
+    // Only a new key is copied into the table.
+    ASSERT_EQ(CountingKey::copies, 3);
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <array>
+    #include <cmath>
+    #include <numeric>
+    #include <vector>
+
+#endif
+
+#include <beman/scan_view/linear_recurrence.hpp>
+#include <beman/scan_view/scan.hpp>
+
+namespace exe = beman::scan_view;
+
+TEST(LinearRecurrence, General) {
+    std::vector<int> a        = {2, 3, 1, 2};
+    std::vector<int> b        = {1, 0, 5, -1};
+    auto             y        = exe::linear_recurrence(a, b, 1);
+    int              expected = 1;
+    std::vector<int> check;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        check.push_back(expected = a[i] * expected + b[i]);
+    ASSERT_TRUE(std::ranges::equal(y, check));
+    const auto& cy = y;
+    ASSERT_TRUE(std::ranges::equal(cy, check));
+
+    // The shorter range determines the length.
+    std::vector<int> shorter = {1, 1};
+    ASSERT_EQ(exe::linear_recurrence(a, shorter, 0).size(), 2);
+    ASSERT_EQ(std::ranges::distance(exe::linear_recurrence(a, shorter, 0)), 2);
+    ASSERT_TRUE(std::ranges::empty(exe::linear_recurrence(a, std::vector<int>{}, 0)));
+}
+
+TEST(LinearRecurrence, Constexpr) {
+    static constexpr std::array<int, 3> a        = {1, 2, 3};
+    static constexpr std::array<int, 3> b        = {1, 1, 1};
+    static constexpr auto               y        = exe::linear_recurrence(a, b, 0);
+    static constexpr std::array<int, 3> expected = {1, 3, 10};
+    static_assert(std::ranges::equal(y, expected));
+}
+
+TEST(LinearRecurrence, Properties) {
+    std::vector<double> a = {0.5, 0.5};
+    std::vector<double> b = {1.0, 1.0};
+    auto                y = exe::linear_recurrence(a, b, 0.0);
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(y)>, double>);
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(y)>, const double&>);
+    static_assert(std::ranges::input_range<decltype(y)> && !std::ranges::forward_range<decltype(y)>);
+    static_assert(std::ranges::sized_range<decltype(y)>);
+    static_assert(std::ranges::borrowed_range<decltype(y)>);
+}
+
+TEST(LinearRecurrence, ExponentialMovingAverage) {
+    // y[i] = (1 - alpha) * y[i - 1] + alpha * x[i]
+    const double        alpha = 0.25;
+    std::vector<double> x(64);
+    std::iota(x.begin(), x.end(), 1.0);
+    std::vector<double> a(x.size(), 1.0 - alpha);
+    std::vector<double> b;
+    for (double v : x)
+        b.push_back(alpha * v);
+
+    auto ema = exe::scan(x, [alpha](double y, double v) { return (1.0 - alpha) * y + alpha * v; }, 0.0);
+    auto rec = exe::linear_recurrence(a, b, 0.0);
+    ASSERT_TRUE(std::ranges::equal(
+        rec, ema, [](double l, double r) { return std::abs(l - r) <= 1e-12 * std::max(1.0, std::abs(r)); }));
+}
+
+TEST(LinearRecurrence, Float) {
+    std::vector<float> a(100, 0.9f);
+    std::vector<float> b;
+    for (int i = 0; i < 100; ++i)
+        b.push_back(0.1f * static_cast<float>(i % 7));
+
+    auto y = exe::linear_recurrence(a, b, 1.0f);
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(y)>, float>);
+    double             expected = 1.0;
+    std::vector<float> check;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        check.push_back(static_cast<float>(expected = a[i] * expected + b[i]));
+    ASSERT_TRUE(std::ranges::equal(
+        y, check, [](float l, float r) { return std::abs(l - r) <= 1e-5f * std::max(1.0f, std::abs(r)); }));
+
+    exe::affine<float> f{0.5f, 1.0f}, g{3.0f, -2.0f};
+    ASSERT_EQ(exe::affine_compose{}(f, g)(4.0f), g(f(4.0f)));
+}
+
+TEST(LinearRecurrence, AffineScan) {
+    std::vector<exe::affine<long>> maps = {{2, 1}, {3, 0}, {1, 5}, {2, -1}};
+    std::vector<long>              serial;
+    for (long y : exe::scan(maps, exe::affine_apply{}, 1L))
+        serial.push_back(y);
+
+    // Composition is associative, so the prefix maps may be computed by any scan algorithm (including parallel ones)
+    // and then applied to the initial value independently.
+    std::vector<exe::affine<long>> prefix(maps.size());
+    std::inclusive_scan(maps.begin(), maps.end(), prefix.begin(), exe::affine_compose{});
+    std::vector<long> applied;
+    for (const auto& f : prefix)
+        applied.push_back(f(1));
+    ASSERT_EQ(applied, serial);
+
+    auto whole = std::reduce(maps.begin(), maps.end(), exe::affine<long>{}, exe::affine_compose{});
+    ASSERT_EQ(whole, prefix.back());
+    ASSERT_EQ(whole(1), serial.back());
+
+    auto lazy_prefix = exe::scan(maps, exe::affine_compose{});
+    ASSERT_TRUE(std::ranges::equal(lazy_prefix, prefix));
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <cstddef>
+    #include <cstdint>
+    #include <functional>
+    #include <ranges>
+    #include <type_traits>
+    #include <vector>
+    #include <version>
+    #if defined(__cpp_lib_mdspan)
+        #include <mdspan>
+    #endif
+
+#endif
+
+#include <beman/scan_view/mdscan.hpp>
+
+namespace exe = beman::scan_view;
+
+namespace {
+
+std::vector<long> naiveSummedArea(const std::vector<long>& in, std::size_t cols) {
+    const std::size_t rows = in.size() / cols;
+    std::vector<long> out(in.size());
+    for (std::size_t i = 0; i < rows; ++i)
+        for (std::size_t j = 0; j < cols; ++j)
+            for (std::size_t r = 0; r <= i; ++r)
+                for (std::size_t c = 0; c <= j; ++c)
+                    out[i * cols + j] += in[r * cols + c];
+    return out;
+}
+
+std::vector<long> grid(std::size_t rows, std::size_t cols) {
+    std::vector<long> in(rows * cols);
+    for (std::size_t k = 0; k < in.size(); ++k)
+        in[k] = static_cast<long>((k * 2654435761u) % 19) - 9;
+    return in;
+}
+
+} // namespace
+
+TEST(MdScan, Eager) {
+    for (auto [rows, cols] : {std::pair<std::size_t, std::size_t>{1, 1}, {3, 4}, {7, 1}, {1, 9}, {5, 5000}}) {
+        auto              in = grid(rows, cols);
+        std::vector<long> out(in.size());
+        exe::mdscan(in, out, cols);
+        ASSERT_EQ(out, naiveSummedArea(in, cols)) << rows << "x" << cols;
+
+        exe::mdscan(in, in, cols);
+        ASSERT_EQ(in, out);
+    }
+
+    std::vector<int> in = {3, 1, 4, 1, 5, 9, 2, 6, 5};
+    std::vector<int> out(in.size());
+    exe::mdscan(in, out, 3, [](int a, int b) { return std::max(a, b); });
+    ASSERT_EQ(out, (std::vector<int>{3, 3, 4, 3, 5, 9, 3, 6, 9}));
+}
+
+TEST(MdScan, PartialLastRow) {
+    // 3 full rows of 5 columns and a last row of 2; zero padding does not change a sum.
+    const std::size_t cols   = 5;
+    auto              padded = grid(4, cols);
+    std::fill(padded.begin() + 17, padded.end(), 0);
+    auto expected = naiveSummedArea(padded, cols);
+    expected.resize(17);
+
+    std::vector<long> in(padded.begin(), padded.begin() + 17);
+    std::vector<long> out(in.size());
+    exe::mdscan(in, out, cols);
+    ASSERT_EQ(out, expected);
+    ASSERT_TRUE(std::ranges::equal(in | exe::summed_area(cols), expected));
+}
+
+TEST(MdScan, RectangleSum) {
+    const std::size_t rows = 6, cols = 7;
+    auto              in   = grid(rows, cols);
+    std::vector<long> sat(in.size());
+    exe::mdscan(in, sat, cols);
+    for (std::size_t r0 = 0; r0 <= rows; ++r0)
+        for (std::size_t r1 = r0; r1 <= rows; ++r1)
+            for (std::size_t c0 = 0; c0 <= cols; ++c0)
+                for (std::size_t c1 = c0; c1 <= cols; ++c1) {
+                    long expected = 0;
+                    for (std::size_t r = r0; r < r1; ++r)
+                        for (std::size_t c = c0; c < c1; ++c)
+                            expected += in[r * cols + c];
+                    ASSERT_EQ(exe::rectangle_sum(sat, cols, r0, c0, r1, c1), expected);
+                }
+}
+
+TEST(MdScan, Lazy) {
+    const std::size_t cols     = 5;
+    auto              in       = grid(4, cols);
+    auto              expected = naiveSummedArea(in, cols);
+
+    auto view = in | exe::summed_area(cols);
+    ASSERT_EQ(view.size(), in.size());
+    ASSERT_TRUE(std::ranges::equal(view, expected));
+    ASSERT_TRUE(std::ranges::equal(exe::summed_area(in, cols, std::plus{}), expected));
+    ASSERT_TRUE(std::ranges::equal(std::as_const(view), expected));
+
+    // A single pass over an input range.
+    auto once = in | std::views::transform([](long x) { return x; }) | exe::summed_area(cols);
+    auto it   = once.begin();
+    for (std::size_t k = 0; k < 7; ++k)
+        ++it;
+    ASSERT_EQ(it.column(), 2u);
+    ASSERT_EQ(*it, expected[7]);
+}
+
+TEST(MdScan, WidensNarrowElements) {
+    // A 4x4 tile of an 8-bit image; its sums exceed 255 and are computed in the result type of `std::plus<>`.
+    std::vector<std::uint8_t> tile(16, 200);
+    auto                      sat = tile | exe::summed_area(4);
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(sat)>, int>);
+    std::vector<int> expected;
+    for (std::size_t k = 0; k < tile.size(); ++k)
+        expected.push_back(static_cast<int>((k / 4 + 1) * (k % 4 + 1) * 200));
+    ASSERT_TRUE(std::ranges::equal(sat, expected));
+}
+
+#if defined(__cpp_lib_mdspan)
+TEST(MdScan, Mdspan) {
+    const std::size_t rows = 4, cols = 6;
+    auto              in   = grid(rows, cols);
+    std::vector<long> out(in.size());
+    exe::mdscan(std::mdspan(in.data(), rows, cols), std::mdspan(out.data(), rows, cols));
+    ASSERT_EQ(out, naiveSummedArea(in, cols));
+    ASSERT_EQ(exe::rectangle_sum(std::mdspan(out.data(), rows, cols), 1, 2, 3, 5),
+              exe::rectangle_sum(out, cols, 1, 2, 3, 5));
+
+    // A column-major view of the same storage is the transposed grid.
+    std::vector<long> transposed(in.size());
+    using left = std::mdspan<long, std::dextents<std::size_t, 2>, std::layout_left>;
+    exe::mdscan(left(in.data(), cols, rows), left(transposed.data(), cols, rows));
+    ASSERT_EQ(transposed, out);
+}
+#endif
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <cstddef>
+    #include <functional>
+    #include <memory_resource>
+    #include <string>
+    #include <string_view>
+    #include <vector>
+
+#endif
+
+#include <beman/scan_view/pmr.hpp>
+
+namespace exe = beman::scan_view;
+
+namespace {
+
+class CountingResource : public std::pmr::memory_resource {
+  public:
+    std::size_t allocations = 0;
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Installs a counting default resource for the lifetime of the object.
+struct DefaultResourceGuard {
+    CountingResource           counting;
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&counting);
+    ~DefaultResourceGuard() { std::pmr::set_default_resource(previous); }
+};
+
+const std::vector<std::string> words = {
+    "a rather long word that does not fit in SSO", "another one, also too long for SSO", "and a third"};
+
+std::vector<std::string> expectedConcatenations() {
+    std::vector<std::string> expected;
+    std::string              acc;
+    for (const auto& w : words)
+        expected.push_back(acc += w);
+    return expected;
+}
+
+auto append = [](std::pmr::string acc, const std::string& w) {
+    acc += w;
+    return acc;
+};
+
+auto sameText = [](std::string_view a, std::string_view b) { return a == b; };
+
+} // namespace
+
+TEST(Pmr, SeedAllocatorIsKept) {
+    CountingResource     counting;
+    const auto           expected = expectedConcatenations();
+    DefaultResourceGuard guard;
+
+    auto scan = exe::scan(words, append, std::pmr::string(&counting));
+    ASSERT_TRUE(std::ranges::equal(scan, expected, sameText));
+    ASSERT_GT(counting.allocations, 0);
+    ASSERT_EQ(guard.counting.allocations, 0);
+}
+
+TEST(Pmr, ScanWithAllocator) {
+    const auto            expected = expectedConcatenations();
+    exe::scan_arena<4096> arena;
+    DefaultResourceGuard  guard;
+
+    auto scan = exe::scan_with_allocator(words, append, std::pmr::string(), &arena);
+    ASSERT_TRUE(std::ranges::equal(scan, expected, sameText));
+    for (const auto& s : scan)
+        ASSERT_EQ(s.get_allocator().resource(), &arena);
+
+    std::pmr::polymorphic_allocator<> alloc(&arena);
+    auto                              piped = words | exe::scan_with_allocator(append, std::pmr::string(), alloc);
+    ASSERT_TRUE(std::ranges::equal(piped, expected, sameText));
+    ASSERT_EQ(guard.counting.allocations, 0);
+}
+
+TEST(Pmr, ArenaFallsBackToUpstream) {
+    CountingResource    upstream;
+    exe::scan_arena<64> arena(&upstream);
+    auto                scan = exe::scan_with_allocator(words, append, std::pmr::string(), &arena);
+    ASSERT_TRUE(std::ranges::equal(scan, expectedConcatenations(), sameText));
+    ASSERT_GT(upstream.allocations, 0);
+}
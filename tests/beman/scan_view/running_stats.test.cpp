@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <cmath>
+    #include <cstddef>
+    #include <cstdint>
+    #include <limits>
+    #include <numeric>
+    #include <ranges>
+    #include <span>
+    #include <string>
+    #include <vector>
+
+#endif
+
+#include <beman/scan_view/exclusive_scan.hpp>
+#include <beman/scan_view/keyed_scan.hpp>
+#include <beman/scan_view/running_stats.hpp>
+
+namespace exe = beman::scan_view;
+
+namespace {
+
+// A statistic that counts how often it is moved.
+struct MoveCounting {
+    int moves = 0;
+    int sum   = 0;
+
+    MoveCounting() = default;
+    MoveCounting(const MoveCounting&) = default;
+    MoveCounting(MoveCounting&& other) noexcept : moves{other.moves + 1}, sum{other.sum} {}
+    MoveCounting& operator=(const MoveCounting&) = default;
+    MoveCounting& operator=(MoveCounting&& other) noexcept {
+        moves = other.moves + 1;
+        sum   = other.sum;
+        return *this;
+    }
+
+    void update(int x) { sum += x; }
+    void merge(const MoveCounting& other) { sum += other.sum; }
+};
+
+// A scan operator with an unrelated member named `accumulate`.
+struct AddsButAccumulateAssigns {
+    int  operator()(int acc, int x) const { return acc + x; }
+    void accumulate(int& acc, int x) const { acc = x; }
+};
+
+template <class R>
+std::ranges::range_value_t<R> lastOf(R&& r) {
+    std::ranges::range_value_t<R> value{};
+    for (auto&& v : r)
+        value = v;
+    return value;
+}
+
+} // namespace
+
+TEST(RunningStats, MeanVariance) {
+    std::vector<double> vec = {2, 4, 4, 4, 5, 5, 7, 9};
+    auto                mv  = vec | exe::running_stat(exe::mean_variance<>{});
+
+    std::size_t n = 0;
+    for (const auto& s : mv) {
+        ++n;
+        const double mean = std::accumulate(vec.begin(), vec.begin() + static_cast<std::ptrdiff_t>(n), 0.0) /
+                            static_cast<double>(n);
+        ASSERT_EQ(s.count(), n);
+        ASSERT_NEAR(s.mean(), mean, 1e-12);
+    }
+    exe::mean_variance<> whole = lastOf(exe::running_stat(vec, exe::mean_variance<>{}));
+    ASSERT_DOUBLE_EQ(whole.mean(), 5.0);
+    ASSERT_DOUBLE_EQ(whole.variance(), 4.0);
+    ASSERT_DOUBLE_EQ(whole.sample_variance(), 32.0 / 7.0);
+
+    exe::mean_variance<> left, right;
+    for (double x : std::span(vec).first(3))
+        left.update(x);
+    for (double x : std::span(vec).subspan(3))
+        right.update(x);
+    auto merged = exe::stat_merge(left, right);
+    ASSERT_EQ(merged.count(), whole.count());
+    ASSERT_NEAR(merged.mean(), whole.mean(), 1e-12);
+    ASSERT_NEAR(merged.variance(), whole.variance(), 1e-12);
+    ASSERT_EQ(exe::stat_merge(exe::mean_variance<>{}, whole), whole);
+}
+
+TEST(RunningStats, Extrema) {
+    std::vector<int> vec = {3, 1, 4, 1, 5, 9, 2, 6, 9};
+    auto             ex  = lastOf(exe::running_stat(vec, exe::extrema<int>{}));
+    ASSERT_EQ(ex.min(), 1);
+    ASSERT_EQ(ex.argmin(), 1u);
+    ASSERT_EQ(ex.max(), 9);
+    ASSERT_EQ(ex.argmax(), 5u);
+    ASSERT_EQ(ex.count(), vec.size());
+
+    exe::extrema<int> left, right;
+    for (int x : std::span(vec).first(4))
+        left.update(x);
+    for (int x : std::span(vec).subspan(4))
+        right.update(x);
+    ASSERT_EQ(exe::stat_merge(left, right), ex);
+
+    // Per-key running maxima with their positions within the key.
+    std::vector<std::string> words    = {"b", "a", "bb", "a", "bbb"};
+    auto                     by_first = exe::keyed_scan(
+        words, [](const std::string& w) { return w[0]; }, exe::stat_update, exe::extrema<std::string>{});
+    std::vector<std::uint64_t> argmax;
+    for (const auto& e : by_first)
+        argmax.push_back(e.argmax());
+    ASSERT_EQ(argmax, (std::vector<std::uint64_t>{0, 0, 1, 0, 2}));
+}
+
+TEST(RunningStats, HyperLogLog) {
+    std::vector<std::uint64_t> vec(200000);
+    for (std::size_t i = 0; i < vec.size(); ++i)
+        vec[i] = i % 50000;
+
+    exe::hyperloglog<> whole;
+    for (auto x : vec)
+        whole.update(x);
+    ASSERT_NEAR(whole.estimate(), 50000.0, 50000.0 * 0.05);
+
+    exe::hyperloglog<> small;
+    for (int x : {1, 2, 3, 2, 1})
+        small.update(x);
+    ASSERT_NEAR(small.estimate(), 3.0, 0.1);
+
+    exe::hyperloglog<> left, right;
+    for (auto x : std::span(vec).first(100000))
+        left.update(x);
+    for (auto x : std::span(vec).subspan(100000))
+        right.update(x);
+    ASSERT_EQ(exe::stat_merge(left, right), whole);
+
+    auto tail = lastOf(exe::running_stat(std::span(vec).first(1000), exe::hyperloglog<10>{}));
+    ASSERT_NEAR(tail.estimate(), 1000.0, 1000.0 * 0.1);
+}
+
+TEST(RunningStats, QuantileSketch) {
+    std::vector<double> vec(10001);
+    for (std::size_t i = 0; i < vec.size(); ++i)
+        vec[i] = static_cast<double>(i) - 2000.0;
+    std::ranges::reverse(vec);
+
+    exe::quantile_sketch sketch(0.01);
+    for (double x : vec)
+        sketch.update(x);
+    ASSERT_EQ(sketch.count(), vec.size());
+    for (double q : {0.0, 0.1, 0.25, 0.5, 0.9, 0.99, 1.0}) {
+        const double exact = -2000.0 + q * 10000.0;
+        ASSERT_NEAR(sketch.quantile(q), exact, std::abs(exact) * 0.01 + 1e-9) << "q " << q;
+    }
+
+    exe::quantile_sketch left(0.01), right(0.01);
+    for (double x : std::span(vec).first(5000))
+        left.update(x);
+    for (double x : std::span(vec).subspan(5000))
+        right.update(x);
+    ASSERT_EQ(exe::stat_merge(left, right).quantile(0.5), sketch.quantile(0.5));
+
+    exe::quantile_sketch bounded(0.01, 64);
+    for (double x : vec)
+        bounded.update(x);
+    ASSERT_NEAR(bounded.quantile(0.99), sketch.quantile(0.99), 1e-9);
+    ASSERT_TRUE(std::isnan(exe::quantile_sketch{}.quantile(0.5)));
+}
+
+TEST(RunningStats, QuantileSketchNonFinite) {
+    constexpr double     inf = std::numeric_limits<double>::infinity();
+    exe::quantile_sketch sketch(0.01);
+    for (double x : {1.0, 2.0, inf, -inf, 3.0, std::numeric_limits<double>::quiet_NaN()})
+        sketch.update(x);
+    ASSERT_EQ(sketch.count(), 5u);
+    ASSERT_EQ(sketch.quantile(0.0), -inf);
+    ASSERT_EQ(sketch.quantile(1.0), inf);
+    ASSERT_NEAR(sketch.quantile(0.5), 2.0, 0.02);
+
+    exe::quantile_sketch left(0.01), right(0.01);
+    left.update(inf);
+    right.update(1.0);
+    ASSERT_EQ(exe::stat_merge(right, left).quantile(1.0), inf);
+    ASSERT_NEAR(exe::stat_merge(right, left).quantile(0.0), 1.0, 0.01);
+
+    exe::quantile_sketch nan_only;
+    nan_only.update(std::numeric_limits<double>::quiet_NaN());
+    ASSERT_EQ(nan_only.count(), 0u);
+    ASSERT_TRUE(std::isnan(nan_only.quantile(0.5)));
+}
+
+TEST(RunningStats, UpdatesInPlace) {
+    std::vector<int> vec(100, 1);
+    auto             sums = vec | exe::running_stat(MoveCounting{});
+    auto             it   = sums.begin();
+    const int        base = (*it).moves;
+    for (int i = 1; i < 100; ++i)
+        ++it;
+    ASSERT_EQ((*it).sum, 100);
+    ASSERT_EQ((*it).moves, base);
+
+    std::vector<MoveCounting> parts(4);
+    for (auto& p : parts)
+        p.update(5);
+    ASSERT_EQ(lastOf(exe::scan(parts, exe::stat_merge)).sum, 20);
+}
+
+TEST(RunningStats, AccumulateRequiresOptIn) {
+    std::vector<int> vec        = {1, 2, 3};
+    int              expected[] = {1, 3, 6};
+    ASSERT_TRUE(std::ranges::equal(exe::scan(vec, AddsButAccumulateAssigns{}), expected));
+    ASSERT_TRUE(std::ranges::equal(exe::scan(vec, AddsButAccumulateAssigns{}, 0), expected));
+    ASSERT_TRUE(std::ranges::equal(exe::keyed_scan(vec, [](int) { return 0; }, AddsButAccumulateAssigns{}), expected));
+    int exclusive[] = {0, 1, 3};
+    ASSERT_TRUE(std::ranges::equal(exe::exclusive_scan(vec, AddsButAccumulateAssigns{}, 0), exclusive));
+    static_assert(exe::enable_accumulate_in_place<std::remove_cvref_t<decltype(exe::stat_update)> >);
+    static_assert(!exe::enable_accumulate_in_place<AddsButAccumulateAssigns>);
+}
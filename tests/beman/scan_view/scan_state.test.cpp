@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <beman/scan_view/config.hpp>
+
+#include <gtest/gtest.h>
+
+#if BEMAN_SCAN_VIEW_USE_MODULES()
+
+import std;
+
+#else
+
+    #include <algorithm>
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <functional>
+    #include <list>
+    #include <optional>
+    #include <ranges>
+    #include <span>
+    #include <string>
+    #include <utility>
+    #include <vector>
+
+#endif
+
+#include <beman/scan_view/scan_state.hpp>
+
+namespace exe = beman::scan_view;
+
+struct Stats {
+    double sum;
+    int    max;
+};
+
+template <>
+struct beman::scan_view::state_codec<std::string> {
+    static void encode(const std::string& value, std::vector<std::byte>& out) {
+        for (char c : value)
+            out.push_back(static_cast<std::byte>(c));
+    }
+    static std::optional<std::string> decode(std::span<const std::byte> in) {
+        std::string value(in.size(), '\0');
+        std::memcpy(value.data(), in.data(), in.size());
+        return value;
+    }
+};
+
+TEST(ScanState, CheckpointAndResume) {
+    std::vector<int> history = {3, 1, 4, 1, 5, 9, 2, 6};
+    auto             full    = exe::scan(history, std::plus{});
+
+    auto it = full.begin();
+    for (int i = 0; i < 4; ++i)
+        ++it;
+    auto state = exe::checkpoint(it, std::ranges::begin(history));
+    ASSERT_EQ(state.value, 14);
+    ASSERT_EQ(state.count, 5);
+    ASSERT_EQ(exe::checkpoint(it, 5), state);
+    ASSERT_EQ(exe::checkpoint(std::as_const(full).begin(), std::ranges::cbegin(history)).count, 1);
+
+    std::vector<int> full_values;
+    for (int v : full)
+        full_values.push_back(v);
+    auto resumed = history | std::views::drop(state.count) | exe::resume_scan(std::plus{}, state);
+    ASSERT_TRUE(std::ranges::equal(resumed, std::span(full_values).subspan(5)));
+}
+
+template <class I, class P>
+concept Checkpointable = requires(const I& it, const P& position) { exe::checkpoint(it, position); };
+
+TEST(ScanState, CheckpointConstraints) {
+    std::vector<int> vec = {1, 2, 3};
+    std::list<int>   lst = {1, 2, 3};
+    using VecScan        = decltype(exe::scan(vec, std::plus{}));
+    using ListScan       = decltype(exe::scan(lst, std::plus{}));
+    static_assert(Checkpointable<std::ranges::iterator_t<VecScan>, std::uint64_t>);
+    static_assert(Checkpointable<std::ranges::iterator_t<VecScan>, std::vector<int>::iterator>);
+    static_assert(Checkpointable<std::ranges::iterator_t<ListScan>, std::uint64_t>);
+    // Only the position within a random-access range is computed in constant time.
+    static_assert(!Checkpointable<std::ranges::iterator_t<ListScan>, std::list<int>::iterator>);
+    // Other iterators do not hold the state of a scan.
+    static_assert(!Checkpointable<std::vector<int>::iterator, std::uint64_t>);
+}
+
+TEST(ScanState, TriviallyCopyable) {
+    std::vector<int> vec  = {5, -2, 7};
+    auto             scan = exe::scan(
+        vec, [](Stats s, int x) { return Stats{s.sum + x, std::max(s.max, x)}; }, Stats{0.0, -1000});
+
+    auto it = scan.begin();
+    ++it;
+    auto bytes = exe::serialize_scan_state(exe::checkpoint(it, 2));
+    ASSERT_EQ(bytes.size(), sizeof(std::uint64_t) + sizeof(Stats));
+
+    auto restored = exe::deserialize_scan_state<Stats>(bytes);
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->count, 2);
+    ASSERT_EQ(restored->value.sum, 3.0);
+    ASSERT_EQ(restored->value.max, 5);
+
+    ASSERT_FALSE(exe::deserialize_scan_state<Stats>(std::span(bytes).first(bytes.size() - 1)).has_value());
+    ASSERT_FALSE(exe::deserialize_scan_state<Stats>(std::span(bytes).first(3)).has_value());
+}
+
+TEST(ScanState, UserCodec) {
+    std::vector<std::string> words = {"ab", "c", "def"};
+    auto                     cat   = exe::scan(words, std::plus{}, std::string{});
+
+    auto it = cat.begin();
+    ++it;
+    auto bytes    = exe::serialize_scan_state(exe::checkpoint(it, 2));
+    auto restored = exe::deserialize_scan_state<std::string>(bytes);
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->value, "abc");
+    ASSERT_EQ(restored->count, 2);
+
+    auto        resumed    = exe::resume_scan(words | std::views::drop(restored->count), std::plus{}, *restored);
+    std::string expected[] = {"abcdef"};
+    ASSERT_TRUE(std::ranges::equal(resumed, expected));
+}